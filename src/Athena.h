@@ -7,36 +7,37 @@
 #include "Bitboard.h"
 #include "Board.h"
 #include "DataTypes.h"
+#include "Eval.h"
 #include "MoveData.h"
+#include "MoveList.h"
+#include "MovePicker.h"
 #include "TranspositionHashEntry.h"
 
+// the size of the transposition table (in megabytes) that a search is given if no other size is asked for
+const int DEFAULT_TRANSPOSITION_TABLE_SIZE = 128;
+
 // this class defines the engine itself and is how the best move for a given position is found
 class Athena
 {
 private:
-    enum PieceTypes
-    {
-        PIECE_TYPE_KING,
-        PIECE_TYPE_QUEEN,
-        PIECE_TYPE_ROOK,
-        PIECE_TYPE_BISHOP,
-        PIECE_TYPE_KNIGHT,
-        PIECE_TYPE_PAWN,
-        PIECE_TYPE_NONE,
-    };
-
-    // the depth to which we should search the move tree
+    // the deepest that the iterative deepening search will go (if it is not stopped by time first)
     int mDepth;
 
     // which colour Athena is playing as 
     Colour mSide;
     
     // holds the best move that Athena could find
-    MoveData mMoveToMake;
+    Move mMoveToMake;
 
     // counts the number of nodes that Athena searched
     int mNodes;
 
+    // counts the nodes searched since the time was last checked
+    int mTimeCheckCounter;
+
+    // reads true if the evaluation, time and number of nodes are printed after each search
+    bool mPrintSearchStats;
+
     // limits the total number of half-moves that Athena is able to search down to (for performance reasons)
     int mMaxPly;
 
@@ -52,72 +53,75 @@ private:
     // we actually have a pointer to a Board object, as otherwise we'd have to constantly be passing said Board object between functions
     Board* boardPtr;
 
-    // most valuable victim, least valuable attacker table. used for priotizing the
-    // moves that would result in the largest material gain
-    Byte MVV_LVATable[7][6] =
-    {
-        { 99, 99, 99, 99, 99, 99},  // Victim: K, Attacker: P, N, B, R, Q, K
-        { 20, 19, 19, 18, 17, 16},  // Victim: Q, Attacker: P, N, B, R, Q, K
-        { 15, 14, 14, 13, 12, 11},  // Victim: R, Attacker: P, N, B, R, Q, K
-        { 10, 9, 9, 8, 7, 6},       // Victim: B, Attacker: P, N, B, R, Q, K
-        { 10, 9, 9, 8, 7, 6},       // Victim: N, Attacker: P, N, B, R, Q, K
-        { 5,  4, 4, 3, 2, 1},       // Victim: P, Attacker: P, N, B, R, Q, K
-        { 0,  0, 0, 0, 0, 0},       // Victim: None, Attacker: P, N, B, R, Q, K
-    };
-    
-    PieceTypes getPieceType(Bitboard* pieceBB);
-    int getPieceValue(PieceTypes pieceType);
-    int pieceValueTo_MVV_LVA_Index(int value);
-    
     int mTranspositionTableSize;
 
     // first element is the origin square, second element is the target square
     int mHistoryHeuristic[64][64];
 
     // holds the list of 2 killer moves for each ply
-    MoveData** mKillerMoves;
+    Move** mKillerMoves;
 
-    void insertKillerMove(MoveData& move, Byte ply);
+    void insertKillerMove(Move move, Byte ply);
     
     // points to a large table of transpositions 
     TranspositionHashEntry* mTranspositionTable;
 
+    // the evaluations of the pawn structures that have been seen by this instance's searches
+    Eval::PawnHashTable mPawnHashTable;
+
+    // what is known about each combination of numbers of pieces that this instance's searches have seen
+    Eval::MaterialHashTable mMaterialHashTable;
+
     void clearTranspositionTable();
     void insertTranspositionEntry(ZobristKey::zkey zobristKey, 
-								  Byte bestMoveOriginSquare,
+								  Move bestMove,
 								  int depth, 
                                   int eval,
 								  TranspositionHashEntry::HashFlagValues flag);
                                   
     int readTranspositionEntry(ZobristKey::zkey zobristKey, int depth, int alpha, int beta);
     
+    // the side to move is a template parameter, so that each side gets its own version of the search (in which everything
+    // that depends on the side to move is known at compile time). the side only has to be branched on at the root
+    template <Colour side>
     int negamax
         (
         int depth, 
-        Colour side, 
         int alpha, 
         int beta, 
         Byte ply, 
-        MoveData* lastMove, 
+        Move lastMove, 
         bool canNullMove,
         bool isReducedSearch
         );
-    int quietMoveSearch(Colour side, int alpha, int beta, Byte ply);
+    template <Colour side>
+    int quietMoveSearch(int alpha, int beta, Byte ply);
 
-    void assignMoveScores(std::vector<MoveData>& moves, Byte ply, ZobristKey::zkey zkey, Colour side);
-    void selectMove(std::vector<MoveData>& moves, Byte startIndex);
+    Move getTranspositionMove(ZobristKey::zkey zkey);
     int calculateExtension(Colour side, Byte kingSquare);
 
     void checkTimeLeft();
     
 public:
-    Athena();
+    explicit Athena(int transpositionTableSizeMB = DEFAULT_TRANSPOSITION_TABLE_SIZE);
+    ~Athena();
+
+    // each instance owns its tables, so it cannot be copied
+    Athena(const Athena&) = delete;
+    Athena& operator=(const Athena&) = delete;
     
-	MoveData search(Board* board, float timeToMove);
+	Move search(Board* board, float timeToMove);
     std::string getOpeningBookMove(Board* board, const std::vector<std::string>& lanStringHistory);
 
     void setTranspositionTableSize(int newSize);
+    void setPawnHashTableSize(int newSize) { mPawnHashTable.resize(newSize); }
+    void resetSearchData();
+
 	void setDepth(int newDepth) { mDepth = newDepth; }
+    int getDepth()              { return mDepth;     }
+    int getNodes()              { return mNodes;     }
     void setColour(Colour side) { mSide = side;      }
     Colour getColour()          { return mSide;      }
+
+    void setPrintSearchStats(bool printSearchStats) { mPrintSearchStats = printSearchStats; }
 };
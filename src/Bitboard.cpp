@@ -3,64 +3,13 @@
 
 #include "Bitboard.h"
 
+#if ATHENA_AVX2_AVAILABLE
+	#include <immintrin.h>
+#endif
+
 namespace BB
 {
-    /* initialize all of the global variables defined in Bitboard.h so that they may be used elsewhere by the engine */
-    
-    extern Bitboard adjacentFiles[8] { 0 };
-	extern Bitboard eastFile[8]      { 0 };
-	extern Bitboard westFile[8]      { 0 };
-
-    extern Bitboard boardSquares[64] { 0 };
-
-    extern Bitboard fileClear[8]     { 0 };
-    extern Bitboard fileMask[8]      { 0 };
-
-    extern Bitboard rankClear[8]     { 0 };
-    extern Bitboard rankMask[8]      { 0 };
-
-    // initializes the arrays that mask or clear entire rows and ranks
-    void initFileRankMasks()
-    {
-        // i representing the rank/file (A-H or 1-8)
-        for (int i = 0; i < 8; i++)
-        {
-            // intentional overflow making fileClear[i]'s and rankClear[i]'s bits all set to 1
-            fileClear[i] = (Bitboard)(-1);
-            rankClear[i] = (Bitboard)(-1);
-
-            // j represeneting the file for rankClear and rankMask, while also representing the rank for fileClear and fileMask
-            for (int j = 0; j < 8; j++)
-            {
-                // reset an entire file's bits to 0
-                fileClear[i] ^= (Bitboard)1 << j * 8 + i;
-
-                // set an entire file's bits to 1
-                fileMask[i]  |= (Bitboard)1 << j * 8 + i;
-                
-                // reset an entire rank's bits to 0
-                rankClear[i] ^= (Bitboard)1 << i * 8 + j;
-
-                // set an entire rank's bits to 1
-                rankMask[i]  |= (Bitboard)1 << i * 8 + j;
-            }
-        }
-    }
-
-    // initalizes the west, east, and adjacent files arrays. a description of what the arrays do can be found at their declaration in Bitboard.h
-    void initAdjacentFilesBitboards()
-    {
-        for (int i = 0; i < 8; i++)
-        {
-            // the below if statements ensure that the westFile array has no file set for the file to the west of file A,
-            // and that the eastFile array has no file set for the file to the east of file H 
-            if (i > 0) westFile[i] |= fileMask[i - 1];
-            if (i < 7) eastFile[i] |= fileMask[i + 1];
-
-            // each element in the adjacentFiles array is just the Bitboard with 1s set for the files to the east/west of the index
-            adjacentFiles[i] |= westFile[i] | eastFile[i];
-        }
-    }
+    bool useAVX2SlidingAttacks = false;
 
     // uses the standard output to print the bitboard provided as the arguement
     void printBitboard(Bitboard bitboard)
@@ -98,15 +47,90 @@ namespace BB
         std::cout << std::endl;
     }
 
-    // initializes all of the general purpose bitboards that Athena will be using
+    // the general purpose bitboards are generated at compile time, so all that is left to do when the engine starts
+    // is to check which version of the setwise sliding fills the processor is able to run
     void initialize()
     {
-        initFileRankMasks();
-        initAdjacentFilesBitboards();
-        
-        // set exactly one bit in each Bitboard of the array that represents each individual square
-        for (int square = 0; square < 64; square++)
-            boardSquares[square] = (Bitboard)1 << square;
+#if ATHENA_AVX2_AVAILABLE
+        __builtin_cpu_init();
+        useAVX2SlidingAttacks = __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // the squares attacked north, south, east and west by the sliders in the set
+    Bitboard orthogonalAttacks(Bitboard slidersBB, Bitboard emptyBB)
+    {
+        return slidingFill< 8>(slidersBB, emptyBB, ~Bitboard(0)) | slidingFill<-8>(slidersBB, emptyBB, ~Bitboard(0)) |
+               slidingFill< 1>(slidersBB, emptyBB, NOT_FILE_A)   | slidingFill<-1>(slidersBB, emptyBB, NOT_FILE_H);
+    }
+
+    // the squares attacked along both diagonals in both directions by the sliders in the set
+    Bitboard diagonalAttacks(Bitboard slidersBB, Bitboard emptyBB)
+    {
+        return slidingFill< 9>(slidersBB, emptyBB, NOT_FILE_A) | slidingFill<-9>(slidersBB, emptyBB, NOT_FILE_H) |
+               slidingFill< 7>(slidersBB, emptyBB, NOT_FILE_H) | slidingFill<-7>(slidersBB, emptyBB, NOT_FILE_A);
+    }
+
+#if ATHENA_AVX2_AVAILABLE
+    /*
+        the avx2 version fills the four directions that shift up the board (north, northeast, northwest and east) in the four lanes of one register,
+        and the four that shift down the board (south, southwest, southeast and west) in the lanes of another. each lane has its own shift amount and
+        wrap mask, so the same three steps as slidingFill are run on all eight directions at once. the orthogonal sliders are put in the lanes of the
+        north/south and east/west directions, and the diagonal sliders in the others
+    */
+    // this is the only function compiled with AVX2 enabled, so that the rest of the engine still runs on processors without it
+    __attribute__((target("avx2")))
+    void slidingAttacksAVX2(Bitboard orthogonalBB, Bitboard diagonalBB, Bitboard emptyBB, Bitboard* orthogonalAttacksBB, Bitboard* diagonalAttacksBB)
+    {
+        // the lanes are set from the highest to the lowest, so lane 0 (north/south) is the last argument
+        const __m256i shifts        = _mm256_set_epi64x(1, 7, 9, 8);
+        const __m256i upWrapMasks   = _mm256_set_epi64x(NOT_FILE_A, NOT_FILE_H, NOT_FILE_A, ~Bitboard(0));
+        const __m256i downWrapMasks = _mm256_set_epi64x(NOT_FILE_H, NOT_FILE_A, NOT_FILE_H, ~Bitboard(0));
+
+        const __m256i doubleShifts    = _mm256_slli_epi64(shifts, 1);
+        const __m256i quadrupleShifts = _mm256_slli_epi64(shifts, 2);
+
+        __m256i upSliders   = _mm256_set_epi64x(orthogonalBB, diagonalBB, diagonalBB, orthogonalBB);
+        __m256i downSliders = upSliders;
+
+        __m256i upEmpty   = _mm256_and_si256(_mm256_set1_epi64x(emptyBB), upWrapMasks);
+        __m256i downEmpty = _mm256_and_si256(_mm256_set1_epi64x(emptyBB), downWrapMasks);
+
+        upSliders   = _mm256_or_si256(upSliders,   _mm256_and_si256(upEmpty,   _mm256_sllv_epi64(upSliders,   shifts)));
+        downSliders = _mm256_or_si256(downSliders, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downSliders, shifts)));
+        upEmpty     = _mm256_and_si256(upEmpty,   _mm256_sllv_epi64(upEmpty,   shifts));
+        downEmpty   = _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downEmpty, shifts));
+
+        upSliders   = _mm256_or_si256(upSliders,   _mm256_and_si256(upEmpty,   _mm256_sllv_epi64(upSliders,   doubleShifts)));
+        downSliders = _mm256_or_si256(downSliders, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downSliders, doubleShifts)));
+        upEmpty     = _mm256_and_si256(upEmpty,   _mm256_sllv_epi64(upEmpty,   doubleShifts));
+        downEmpty   = _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downEmpty, doubleShifts));
+
+        upSliders   = _mm256_or_si256(upSliders,   _mm256_and_si256(upEmpty,   _mm256_sllv_epi64(upSliders,   quadrupleShifts)));
+        downSliders = _mm256_or_si256(downSliders, _mm256_and_si256(downEmpty, _mm256_srlv_epi64(downSliders, quadrupleShifts)));
+
+        __m256i attacks = _mm256_or_si256(_mm256_and_si256(_mm256_sllv_epi64(upSliders,   shifts), upWrapMasks),
+                                          _mm256_and_si256(_mm256_srlv_epi64(downSliders, shifts), downWrapMasks));
+
+        alignas(32) Bitboard lanes[4];
+        _mm256_store_si256((__m256i*)lanes, attacks);
+
+        *orthogonalAttacksBB = lanes[0] | lanes[3];
+        *diagonalAttacksBB   = lanes[1] | lanes[2];
+    }
+#endif
+
+    void slidingAttacks(Bitboard orthogonalBB, Bitboard diagonalBB, Bitboard emptyBB, Bitboard* orthogonalAttacksBB, Bitboard* diagonalAttacksBB)
+    {
+#if ATHENA_AVX2_AVAILABLE
+        if (useAVX2SlidingAttacks)
+        {
+            slidingAttacksAVX2(orthogonalBB, diagonalBB, emptyBB, orthogonalAttacksBB, diagonalAttacksBB);
+            return;
+        }
+#endif
+        *orthogonalAttacksBB = orthogonalAttacks(orthogonalBB, emptyBB);
+        *diagonalAttacksBB   = diagonalAttacks(diagonalBB, emptyBB);
     }
 
     /*
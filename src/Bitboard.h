@@ -1,7 +1,16 @@
 #pragma once
 
+#include <array>
 #include <cinttypes>
 
+// the avx2 version of the setwise sliding fills can only be built by x86-64 compilers that are able to target AVX2 for a single function,
+// as the rest of the engine must still run on processors without it (which version is used is decided when the engine starts)
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#define ATHENA_AVX2_AVAILABLE 1
+#else
+	#define ATHENA_AVX2_AVAILABLE 0
+#endif
+
 typedef uint64_t Bitboard;
 
 constexpr bool SIDE_WHITE = false;
@@ -35,15 +44,125 @@ namespace BB
 	};
 
 	// functions for bit shifting a bitboard in some direction as to get the corresponding resultant bitboard 
-	inline Bitboard northEastOne(Bitboard bb)  { return bb << 9; }
-	inline Bitboard northOne(Bitboard bb) 	   { return bb << 8; }
-	inline Bitboard northWestOne(Bitboard bb)  { return bb << 7; }
-	inline Bitboard westOne(Bitboard bb) 	   { return bb << 1; }
-	inline Bitboard eastOne(Bitboard bb) 	   { return bb >> 1; }
-	inline Bitboard southWestOne(Bitboard bb)  { return bb >> 9; }
-	inline Bitboard southOne(Bitboard bb) 	   { return bb >> 8; }
-	inline Bitboard southEastOne(Bitboard bb)  { return bb >> 7; }
+	constexpr Bitboard northEastOne(Bitboard bb)  { return bb << 9; }
+	constexpr Bitboard northOne(Bitboard bb) 	   { return bb << 8; }
+	constexpr Bitboard northWestOne(Bitboard bb)  { return bb << 7; }
+	constexpr Bitboard westOne(Bitboard bb) 	   { return bb << 1; }
+	constexpr Bitboard eastOne(Bitboard bb) 	   { return bb >> 1; }
+	constexpr Bitboard southWestOne(Bitboard bb)  { return bb >> 9; }
+	constexpr Bitboard southOne(Bitboard bb) 	   { return bb >> 8; }
+	constexpr Bitboard southEastOne(Bitboard bb)  { return bb >> 7; }
+
+	// shifts a bitboard one rank towards the side of the board that the given side's pawns move towards (north for white, south for black)
+	// the side is a template parameter so that the direction of the shift is decided at compile time
+	template <bool side>
+	constexpr Bitboard forwardOne(Bitboard bb)    { if constexpr (side == SIDE_WHITE) return northOne(bb); else return southOne(bb); }
+
+	template <bool side>
+	constexpr Bitboard backwardOne(Bitboard bb)   { if constexpr (side == SIDE_WHITE) return southOne(bb); else return northOne(bb); }
+
+	// shifts every bit of a bitboard by the same number of squares (up the board for a positive amount, down for a negative amount)
+	// note that this does not stop bits from wrapping around to the other side of the board, so the files that would wrap must be cleared first
+	template <int amount>
+	inline Bitboard shift(Bitboard bb)         { if constexpr (amount > 0) return bb << amount; else return bb >> -amount; }
+
+	// every square except those on the A file or the H file. a bitboard shifted towards the east (or west) must have these
+	// masked in afterwards, as the bits that were on the H file (or A file) would otherwise wrap around to the other side of the board
+	constexpr Bitboard NOT_FILE_A = 0xfefefefefefefefeULL;
+	constexpr Bitboard NOT_FILE_H = 0x7f7f7f7f7f7f7f7fULL;
+
+	/*
+		kogge-stone fills slide every piece in a set in one direction at once, so the attacks of all of a side's sliders can be found
+		without looping over them. the set is spread out by 1, 2 and then 4 squares, each time only through empty squares (the "propagator"),
+		which covers the up to 7 squares that a slider can move. more info at https://www.chessprogramming.org/Kogge-Stone_Algorithm
+	*/
+	// returns the squares attacked in one direction (given as the amount that a square is shifted by for each step) by all of the sliders in the set
+	// the wrap mask is NOT_FILE_A for directions that step towards the east, NOT_FILE_H for those that step towards the west, and every square otherwise
+	template <int amount>
+	inline Bitboard slidingFill(Bitboard slidersBB, Bitboard emptyBB, Bitboard wrapMaskBB)
+	{
+		emptyBB &= wrapMaskBB;
+
+		slidersBB |= emptyBB & shift<amount>(slidersBB);
+		emptyBB   &= shift<amount>(emptyBB);
+		slidersBB |= emptyBB & shift<amount * 2>(slidersBB);
+		emptyBB   &= shift<amount * 2>(emptyBB);
+		slidersBB |= emptyBB & shift<amount * 4>(slidersBB);
+
+		// the fill includes the sliders themselves and stops just before the first blocker, so it is shifted one more step to reach the blockers
+		return shift<amount>(slidersBB) & wrapMaskBB;
+	}
+
+	// returns every square attacked by the rooks (or queens) in the set, or the bishops (or queens) in the set, given the empty squares of the board
+	Bitboard orthogonalAttacks(Bitboard slidersBB, Bitboard emptyBB);
+	Bitboard diagonalAttacks(Bitboard slidersBB, Bitboard emptyBB);
+
+	// finds the attacks of both a set of orthogonal sliders and a set of diagonal sliders at once (which lets all 8 directions be filled in parallel)
+	void slidingAttacks(Bitboard orthogonalBB, Bitboard diagonalBB, Bitboard emptyBB, Bitboard* orthogonalAttacksBB, Bitboard* diagonalAttacksBB);
+
+	// when true, slidingAttacks fills four directions at once in each of two avx2 registers. it is set when the engine starts if the processor supports avx2
+	extern bool useAVX2SlidingAttacks;
+
+	// returns the rank as it would be seen from the given side's point of view (so black's first rank is the eighth rank)
+	template <bool side>
+	constexpr Rank relativeRank(Rank rank)     { return side == SIDE_WHITE ? rank : Rank(RANK_EIGHTH - rank); }
 	
+	/*
+		all of the tables below are generated at compile time (so they are in read-only memory as soon as the engine starts, and
+		nothing has to be initialized before they can be used). the checks at the bottom of this file make sure that they came out right
+	*/
+
+	// an array of Bitboards, with each element representing one individual square (each element has only 1 bit set in its entire Bitboard)
+	inline constexpr std::array<Bitboard, 64> boardSquares = []
+	{
+		std::array<Bitboard, 64> squares {};
+		for (int square = 0; square < 64; square++)
+			squares[square] = (Bitboard)1 << square;
+
+		return squares;
+	}();
+
+	// an array that contains Bitboards with one file masked (set to 1s) and the rest cleared (set to 0s)
+	inline constexpr std::array<Bitboard, 8> fileMask = []
+	{
+		std::array<Bitboard, 8> masks {};
+		for (int file = 0; file < 8; file++)
+			for (int rank = 0; rank < 8; rank++)
+				masks[file] |= (Bitboard)1 << (rank * 8 + file);
+
+		return masks;
+	}();
+
+	// an array that contains Bitboards with one rank masked (set to 1s) and the rest cleared (set to 0s)
+	inline constexpr std::array<Bitboard, 8> rankMask = []
+	{
+		std::array<Bitboard, 8> masks {};
+		for (int rank = 0; rank < 8; rank++)
+			masks[rank] = (Bitboard)0xff << (rank * 8);
+
+		return masks;
+	}();
+
+	// an array that contains Bitboards with one file cleared (set to 0s) and the rest masked (set to 1s)
+	inline constexpr std::array<Bitboard, 8> fileClear = []
+	{
+		std::array<Bitboard, 8> clears {};
+		for (int file = 0; file < 8; file++)
+			clears[file] = ~fileMask[file];
+
+		return clears;
+	}();
+
+	// an array that contains Bitboards with one rank cleared (set to 0s) and the rest masked (set to 1s)
+	inline constexpr std::array<Bitboard, 8> rankClear = []
+	{
+		std::array<Bitboard, 8> clears {};
+		for (int rank = 0; rank < 8; rank++)
+			clears[rank] = ~rankMask[rank];
+
+		return clears;
+	}();
+
 	/*
 		each element in the eastFile array is a Bitboard with one entire file set (except for the 8th element, as there is no file to the east of the H file)
 		likewise, each element in the westFile array has Bitboards with just one file set (save for the 1st element, as there are no files to the west of the A file)
@@ -54,27 +173,50 @@ namespace BB
 		the adjacentFiles array returns a Bitboard with both one to the east and one to the west files set to 1s (should it be possible. for instance, indexing the
 		first element would mean that there would be no west file set, as there is no file to the west of the A file)
 	*/
-	extern Bitboard eastFile[8];
-	extern Bitboard westFile[8];
-	extern Bitboard adjacentFiles[8];
+	inline constexpr std::array<Bitboard, 8> eastFile = []
+	{
+		std::array<Bitboard, 8> files {};
+		for (int file = 0; file < 7; file++)
+			files[file] = fileMask[file + 1];
 
-	// an array of Bitboards, with each element representing one individual square (each element has only 1 bit set in its entire Bitboard)
-    extern Bitboard boardSquares[64];
+		return files;
+	}();
 
-	// an array that contains Bitboards with one file cleared (set to 0s) and the rest masked (set to 1s)
-    extern Bitboard fileClear[8];
+	inline constexpr std::array<Bitboard, 8> westFile = []
+	{
+		std::array<Bitboard, 8> files {};
+		for (int file = 1; file < 8; file++)
+			files[file] = fileMask[file - 1];
 
-	// an array that contains Bitboards with one file masked (set to 1s) and the rest cleared (set to 0s)
-    extern Bitboard fileMask[8];
+		return files;
+	}();
 
-	// an array that contains Bitboards with one rank cleared (set to 0s) and the rest masked (set to 1s)
-    extern Bitboard rankClear[8];
+	inline constexpr std::array<Bitboard, 8> adjacentFiles = []
+	{
+		std::array<Bitboard, 8> files {};
+		for (int file = 0; file < 8; file++)
+			files[file] = westFile[file] | eastFile[file];
 
-	// an array that contains Bitboards with one rank masked (set to 1s) and the rest cleared (set to 0s)
-    extern Bitboard rankMask[8];
+		return files;
+	}();
+
+	// the tables must agree with the wrap masks above, and with the square mapping (A1 is the lowest bit, H8 is the highest)
+	static_assert(boardSquares[0] == 1 && boardSquares[63] == (Bitboard)1 << 63,                  "boardSquares does not map A1 to bit 0 and H8 to bit 63");
+	static_assert(fileClear[FILE_A] == NOT_FILE_A && fileClear[FILE_H] == NOT_FILE_H,             "fileClear does not match the wrap masks");
+	static_assert(rankMask[RANK_FIRST] == 0xff && rankClear[RANK_EIGHTH] == 0x00ffffffffffffffULL, "rankMask or rankClear is wrong");
+	static_assert(adjacentFiles[FILE_A] == fileMask[FILE_B] && adjacentFiles[FILE_H] == fileMask[FILE_G], "adjacentFiles is wrong on the edge of the board");
+	static_assert(adjacentFiles[FILE_D] == (fileMask[FILE_C] | fileMask[FILE_E]),               "adjacentFiles is wrong in the middle of the board");
 
     void initialize();
     void printBitboard(Bitboard bitboard);
 	int getLSB(Bitboard bb);
 	int getMSB(Bitboard bb);
+
+	// returns the least significant bit in the Bitboard and unsets it, which allows for looping over only the set bits of a Bitboard
+	inline int popLSB(Bitboard& bb)
+	{
+		int lsb = getLSB(bb);
+		bb &= bb - 1;
+		return lsb;
+	}
 }
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <iostream>
+#include <iterator>
 #include <random>
 
 #include "Board.h"
@@ -9,55 +12,87 @@
 #include "Outcomes.h"
 #include "utils.h"
 
-// this namespace and enum represent the format of the FEN string passed in for setting the board position
-namespace FenDataFields
+// the characters used for each colour and type of piece in FEN strings (indexed by side and then by PieceType)
+const char FEN_PIECE_CHARACTERS[2][7] = { "PNBRQK", "pnbrqk" };
+
+// the characters that separate the fields of a FEN or EPD string. line endings are included, so that lines read from files can be
+// parsed as they are
+const char FEN_FIELD_SEPARATORS[] = " \t\r\n";
+
+// the largest full move number accepted from a FEN string (far more than any real game, while small enough that the ply it
+// corresponds to cannot overflow)
+const int MAX_FEN_FULL_MOVES = 1000000;
+
+// longer than the longest FEN string that getFEN can write, so that it can be written into a buffer on the stack
+const int MAX_FEN_LENGTH = 128;
+
+// the character of each castle privilege in a FEN string (in the order that they are written), and the squares that the king and
+// the rook must be on for the privilege to be possible
+struct FENCastlePrivilege
 {
-	enum FEN_FIELDS
-	{
-		PIECE_PLACEMENT,
-		SIDE_TO_PLAY,
-		CASTLE_PRIVILEGES,
-		EN_PASSANT_SQUARE,
-		FIFTY_MOVE_COUNTER,
-		NUM_FULL_MOVES,
-	};
-}
+	char character;
+	CastlingPrivilege privilege;
+	Colour side;
+	Byte kingSquare;
+	Byte rookSquare;
+};
+
+const FENCastlePrivilege fenCastlePrivileges[4] =
+{
+	{ 'K', CastlingPrivilege::WHITE_SHORT_CASTLE, SIDE_WHITE, ChessCoord::E1, ChessCoord::H1 },
+	{ 'Q', CastlingPrivilege::WHITE_LONG_CASTLE,  SIDE_WHITE, ChessCoord::E1, ChessCoord::A1 },
+	{ 'k', CastlingPrivilege::BLACK_SHORT_CASTLE, SIDE_BLACK, ChessCoord::E8, ChessCoord::H8 },
+	{ 'q', CastlingPrivilege::BLACK_LONG_CASTLE,  SIDE_BLACK, ChessCoord::E8, ChessCoord::A8 },
+};
+
+// the castle privileges that are revoked whenever a piece moves from or to each square. that is, a king or rook leaving its
+// starting square, or a rook being captured on its starting square (the values are combinations of the CastlingPrivilege bits)
+const Byte castlePrivilegesRevokedBySquare[64] =
+{
+	1, 0, 0, 0, 3, 0, 0, 2,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0,
+	4, 0, 0, 0, 12, 0, 0, 8,
+};
 
 // sets appropriate bits on white/black pieces bitboards and occupied/empty bitboards
-void Board::initializeAuxillaryBitboards()
+void initializeAuxillaryBitboards(ChessPosition& position)
 {
-	currentPosition.whitePiecesBB  = currentPosition.whitePawnsBB | currentPosition.whiteRooksBB | currentPosition.whiteKnightsBB | 
-									 currentPosition.whiteBishopsBB | currentPosition.whiteQueensBB | currentPosition.whiteKingBB;
+	position.whitePiecesBB  = position.whitePawnsBB | position.whiteRooksBB | position.whiteKnightsBB | 
+							  position.whiteBishopsBB | position.whiteQueensBB | position.whiteKingBB;
 
-	currentPosition.blackPiecesBB  = currentPosition.blackPawnsBB | currentPosition.blackRooksBB | currentPosition.blackKnightsBB | 
-									 currentPosition.blackBishopsBB | currentPosition.blackQueensBB | currentPosition.blackKingBB;
+	position.blackPiecesBB  = position.blackPawnsBB | position.blackRooksBB | position.blackKnightsBB | 
+							  position.blackBishopsBB | position.blackQueensBB | position.blackKingBB;
 
-	currentPosition.occupiedBB = currentPosition.whitePiecesBB | currentPosition.blackPiecesBB;
-	currentPosition.emptyBB	   = ~currentPosition.occupiedBB;
+	position.occupiedBB = position.whitePiecesBB | position.blackPiecesBB;
+	position.emptyBB	= ~position.occupiedBB;
 }
 
-// sets a specific bit on the appropriate piece bitboard based on the character and square passed in by the FEN string
-void Board::setFENPiecePlacement(char pieceType, Byte square)
+// sums up the midgame and endgame scores and the material key of the position from scratch (makeMove and unmakeMove keep them up to date after this)
+void computeScores(ChessPosition& position)
 {
-	switch (pieceType)
+	position.midgameScore = 0;
+	position.endgameScore = 0;
+	position.materialKey  = Eval::computeMaterialKey(position);
+
+	for (int square = 0; square < 64; square++)
 	{
-		case 'P': currentPosition.whitePawnsBB	 |= BB::boardSquares[square]; break;
-		case 'p': currentPosition.blackPawnsBB	 |= BB::boardSquares[square]; break;
-		case 'N': currentPosition.whiteKnightsBB |= BB::boardSquares[square]; break;
-		case 'n': currentPosition.blackKnightsBB |= BB::boardSquares[square]; break;
-		case 'B': currentPosition.whiteBishopsBB |= BB::boardSquares[square]; break;
-		case 'b': currentPosition.blackBishopsBB |= BB::boardSquares[square]; break;
-		case 'R': currentPosition.whiteRooksBB   |= BB::boardSquares[square]; break;
-		case 'r': currentPosition.blackRooksBB   |= BB::boardSquares[square]; break;
-		case 'Q': currentPosition.whiteQueensBB  |= BB::boardSquares[square]; break;
-		case 'q': currentPosition.blackQueensBB  |= BB::boardSquares[square]; break;
-		case 'K': currentPosition.whiteKingBB	 |= BB::boardSquares[square]; break;
-		case 'k': currentPosition.blackKingBB	 |= BB::boardSquares[square]; break;
+		if (position.pieces[square] == NO_PIECE)
+			continue;
+
+		Colour side = (position.blackPiecesBB & BB::boardSquares[square]) ? SIDE_BLACK : SIDE_WHITE;
+
+		position.midgameScore += Eval::midgamePieceSquareValues[side][position.pieces[square]][square];
+		position.endgameScore += Eval::endgamePieceSquareValues[side][position.pieces[square]][square];
 	}
 }
 
 // uses ascii text manipulation to find the little endian file mapping coordinate from a letter/number chess coordinate (i.e. a4, h3)
-Byte Board::getSquareNumberCoordinate(const std::string& stringCoordinate)
+Byte Board::getSquareNumberCoordinate(std::string_view stringCoordinate)
 {
 	// calculates the square by multiplying the number (row/rank) by 8, then adding the number (column/file)
 	return (stringCoordinate[1] - ASCII::NUMBER_ONE_CODE) * 8 + (stringCoordinate[0] - ASCII::LETTER_A_CODE);
@@ -75,236 +110,461 @@ std::string Board::getSquareStringCoordinate(Byte square)
 	return moveString;
 }
 
-// interprets all the data from an FEN string. this includes:
-// setting appropriate bits in associated bitboards (i.e. white pawns in the white pawns bitboard, setting occupied bitboard, etc)
-// taking side to move, en passant square, half-move counter, and castle privileges into account  
-void Board::setPositionFEN(const std::string& fenString)
+// returns the next field of a FEN or EPD string, and moves the string past it (or returns an empty field if there are none left)
+// the field only views the string passed in, so that parsing a FEN string does not need to allocate any memory
+std::string_view nextFENField(std::string_view& fenString)
+{
+	size_t fieldStart = std::min(fenString.find_first_not_of(FEN_FIELD_SEPARATORS), fenString.size());
+	fenString.remove_prefix(fieldStart);
+
+	size_t fieldEnd = std::min(fenString.find_first_of(FEN_FIELD_SEPARATORS), fenString.size());
+	std::string_view field = fenString.substr(0, fieldEnd);
+	fenString.remove_prefix(fieldEnd);
+
+	return field;
+}
+
+// reads a field that is made up only of digits, returning false if it is not a number or if the number is larger than the maximum
+bool parseFENNumber(std::string_view field, int maxValue, int* number)
 {
-	currentPosition.reset();
+	const char* fieldEnd = field.data() + field.size();
+	auto [numberEnd, error] = std::from_chars(field.data(), fieldEnd, *number);
 
-	// loop through all the chatacters of the FEN string and set the positions of the pieces into the engine's abstractions
-	int column = 0;
-	int row    = 7;
-	for (int character = 0; character < fenString.size(); character++)
+	return error == std::errc() && numberEnd == fieldEnd && *number >= 0 && *number <= maxValue;
+}
+
+// returns the type of piece that a character of a FEN string's piece placement stands for (or NO_PIECE if it is not a piece)
+PieceType getFENPieceType(char character)
+{
+	switch (character)
 	{
-		// if we get to the data past the placement data there will be a space
-		if (fenString[character] == ' ')
-			break;
-		// a slash indicates a new row (so go down a row and start again from the leftmost column)
-		else if (fenString[character] == '/')
+		case 'P': case 'p': return PAWN;
+		case 'N': case 'n': return KNIGHT;
+		case 'B': case 'b': return BISHOP;
+		case 'R': case 'r': return ROOK;
+		case 'Q': case 'q': return QUEEN;
+		case 'K': case 'k': return KING;
+		default: 			return NO_PIECE;
+	}
+}
+
+// sets the pieces of the position from the first field of a FEN string, returning false unless the field has exactly 8 ranks of 8 squares
+bool parseFENPiecePlacement(std::string_view placement, ChessPosition& position)
+{
+	// the ranks are given from the eighth rank down, with the squares of each rank from the a file to the h file
+	int rank = 7;
+	int file = 0;
+	for (char character : placement)
+	{
+		// a slash indicates a new rank (so go down a rank and start again from the a file), which can only come after a full rank
+		if (character == '/')
 		{
-			row--;
-			column = 0;
+			if (file != 8 || rank == 0)
+				return false;
+
+			rank--;
+			file = 0;
 		}
-		// a character that is a letter indicates that there exists a piece in that position 
-		else if (fenString[character] > ASCII::NUMBER_NINE_CODE)
+		// a number indicates how many empty squares there are until the next piece on the rank (or until the end of the rank)
+		else if (character >= '1' && character <= '8')
 		{
-			setFENPiecePlacement(fenString[character], row * 8 + column);
-			column++;
+			file += character - '0';
+			if (file > 8)
+				return false;
 		}
-		// a number indicates how many empty squares there are until yet another piece on that rank (or just until the end of the rank, if there are no other pieces)
+		// any other character must be a piece (upper case letters are white pieces, and lower case letters are black pieces)
 		else
-			column += fenString[character] - 48;
+		{
+			PieceType piece = getFENPieceType(character);
+			if (piece == NO_PIECE || file == 8)
+				return false;
+
+			Colour side  = (character >= 'a') ? SIDE_BLACK : SIDE_WHITE;
+			Byte square = rank * 8 + file;
+
+			position.getPieceBB(side, piece) |= BB::boardSquares[square];
+			position.pieces[square] = piece;
+			file++;
+		}
 	}
 
-	// fill a vector with the remaining data (en passant square, castle privileges, half-move counter, side to move) and parse into engine
-	std::vector<std::string> dataVec;
-	splitString(fenString, dataVec, ' ');
+	return rank == 0 && file == 8;
+}
 
-	// set side to move and adjust current ply (using the total number of full moves at the end of the FEN data)
-	if (dataVec[FenDataFields::SIDE_TO_PLAY][0] == 'w')
+// returns true if the numbers of each side's pieces could have come about in a game. a side starts with 8 pawns and 16 pieces in total, and
+// every piece past the starting number of its type (2 knights, bishops and rooks, and 1 queen) must have come from a pawn that promoted
+bool isMaterialPossible(ChessPosition& position)
+{
+	for (Colour side : { SIDE_WHITE, SIDE_BLACK })
 	{
-		mPly = -2; // so that when we add 2 times the number of full moves, we get the proper ply if the side to move is white
-		currentPosition.sideToMove = SIDE_WHITE;
+		int pawns 	= countSetBits64(position.getPieceBB(side, PAWN));
+		int knights = countSetBits64(position.getPieceBB(side, KNIGHT));
+		int bishops = countSetBits64(position.getPieceBB(side, BISHOP));
+		int rooks 	= countSetBits64(position.getPieceBB(side, ROOK));
+		int queens 	= countSetBits64(position.getPieceBB(side, QUEEN));
+
+		int promotedPieces = std::max(knights - 2, 0) + std::max(bishops - 2, 0) + std::max(rooks - 2, 0) + std::max(queens - 1, 0);
+		if (pawns > 8 || countSetBits64(position.getColourBB(side)) > 16 || promotedPieces > 8 - pawns)
+			return false;
 	}
+
+	return true;
+}
+
+// returns true if any piece of the attacking side attacks the square in the position given. unlike squareAttacked, this does not use the
+// board's attack cache, so that it can be used on a position that is not on the board yet
+bool isSquareAttackedInPosition(ChessPosition& position, Byte square, Colour attackingSide)
+{
+	Bitboard diagonalSlidersBB = position.getPieceBB(attackingSide, BISHOP) | position.getPieceBB(attackingSide, QUEEN);
+	Bitboard straightSlidersBB = position.getPieceBB(attackingSide, ROOK)   | position.getPieceBB(attackingSide, QUEEN);
+
+	return (MoveGeneration::pawnAttackLookupTable[!attackingSide][square] & position.getPieceBB(attackingSide, PAWN))   ||
+		   (MoveGeneration::knightLookupTable[square] 					  & position.getPieceBB(attackingSide, KNIGHT)) ||
+		   (MoveGeneration::kingLookupTable[square] 					  & position.getPieceBB(attackingSide, KING))   ||
+		   (MoveGeneration::computePseudoBishopMoves(square, position.occupiedBB, 0) & diagonalSlidersBB) 			 ||
+		   (MoveGeneration::computePseudoRookMoves(square, position.occupiedBB, 0)   & straightSlidersBB);
+}
+
+// parses the side to move, castle privileges and en passant square of a FEN string, returning false if any of them are malformed
+// or are not possible with the pieces of the position (the castle privileges need the king and rook on their starting squares, and
+// the en passant square needs the pawn that was just pushed two squares past it)
+bool parseFENState(std::string_view sideField, std::string_view castleField, std::string_view enPassantField, ChessPosition& position)
+{
+	if (sideField == "w")
+		position.sideToMove = SIDE_WHITE;
+	else if (sideField == "b")
+		position.sideToMove = SIDE_BLACK;
 	else
+		return false;
+
+	if (castleField != "-")
+	{
+		if (castleField.empty())
+			return false;
+
+		for (char character : castleField)
+		{
+			const FENCastlePrivilege* castle = std::find_if(std::begin(fenCastlePrivileges), std::end(fenCastlePrivileges),
+															[character](const FENCastlePrivilege& castle) { return castle.character == character; });
+
+			// each privilege can only be given once
+			if (castle == std::end(fenCastlePrivileges) || (position.castlePrivileges & (Byte)castle->privilege))
+				return false;
+
+			if (!(position.getPieceBB(castle->side, KING) & BB::boardSquares[castle->kingSquare]) || 
+				!(position.getPieceBB(castle->side, ROOK) & BB::boardSquares[castle->rookSquare]))
+				return false;
+
+			position.castlePrivileges |= (Byte)castle->privilege;
+		}
+	}
+
+	if (enPassantField != "-")
 	{
-		mPly = -1; // same as the most recent comment, only for if the side to move is black
-		currentPosition.sideToMove = SIDE_BLACK;
+		// the en passant square is behind a pawn of the side that just moved, which is on the sixth rank if white is to move (and the third if black is)
+		BB::Rank enPassantRank = (position.sideToMove == SIDE_WHITE) ? BB::RANK_SIXTH : BB::RANK_THIRD;
+		if (enPassantField.size() != 2 || enPassantField[0] < 'a' || enPassantField[0] > 'h' || enPassantField[1] != '1' + enPassantRank)
+			return false;
+
+		Byte enPassantSquare = (enPassantField[1] - '1') * 8 + (enPassantField[0] - 'a');
+		Byte pushedPawnSquare = (position.sideToMove == SIDE_WHITE) ? enPassantSquare - 8 : enPassantSquare + 8;
+		Byte pawnOriginSquare = (position.sideToMove == SIDE_WHITE) ? enPassantSquare + 8 : enPassantSquare - 8;
+
+		if (!(position.getPieceBB(!position.sideToMove, PAWN) & BB::boardSquares[pushedPawnSquare]) ||
+			position.pieces[enPassantSquare] != NO_PIECE || position.pieces[pawnOriginSquare] != NO_PIECE)
+			return false;
+
+		position.enPassantSquare = enPassantSquare;
+	}
+
+	return true;
+}
+
+// interprets all the data from a FEN string. this includes:
+// setting appropriate bits in associated bitboards (i.e. white pawns in the white pawns bitboard, setting occupied bitboard, etc)
+// taking side to move, en passant square, half-move counter, and castle privileges into account  
+// the two move counters at the end can be left out, as they are in EPD strings, in which case the operations that come after the first
+// four fields are viewed by epdOperations (if it is given). nothing is allocated while parsing, so that many positions can be parsed quickly
+// returns false (leaving the board as it was) if the string is not a valid FEN string, or if the position it describes is not legal
+bool Board::setPositionFEN(std::string_view fenString, std::string_view* epdOperations)
+{
+	// the position is built up on its own first, so that the board is only changed once the whole string is known to be valid
+	ChessPosition position;
+
+	std::string_view placementField = nextFENField(fenString);
+	std::string_view sideField 		= nextFENField(fenString);
+	std::string_view castleField 	= nextFENField(fenString);
+	std::string_view enPassantField = nextFENField(fenString);
+
+	if (!parseFENPiecePlacement(placementField, position))
+		return false;
+
+	initializeAuxillaryBitboards(position);
+
+	// each side needs exactly one king, pawns can never be on the first or last rank, and no side can have more pieces than it could have
+	// after promoting its missing pawns
+	Bitboard whiteKingBB = position.whiteKingBB;
+	Bitboard blackKingBB = position.blackKingBB;
+	if (!whiteKingBB || (whiteKingBB & (whiteKingBB - 1)) || !blackKingBB || (blackKingBB & (blackKingBB - 1)))
+		return false;
+	if ((position.whitePawnsBB | position.blackPawnsBB) & (BB::rankMask[BB::RANK_FIRST] | BB::rankMask[BB::RANK_EIGHTH]))
+		return false;
+	if (!isMaterialPossible(position))
+		return false;
+
+	if (!parseFENState(sideField, castleField, enPassantField, position))
+		return false;
+
+	// the side that just moved cannot have left its king in check
+	if (isSquareAttackedInPosition(position, computeKingSquare(position.getPieceBB(!position.sideToMove, KING)), position.sideToMove))
+		return false;
+
+	// the move counters are optional, so that EPD strings (which leave them out) can be parsed as well. a field starting with a digit is a
+	// move counter, and anything else starts the EPD operations. counters that are left out are given what they are at the start of a game
+	int fiftyMoveCounter = 0;
+	int fullMoves 		 = 1;
+
+	for (int* counter : { &fiftyMoveCounter, &fullMoves })
+	{
+		std::string_view remainingFields = fenString;
+		std::string_view counterField 	 = nextFENField(remainingFields);
+		if (counterField.empty() || counterField[0] < '0' || counterField[0] > '9')
+			break;
+
+		if (!parseFENNumber(counterField, counter == &fiftyMoveCounter ? 255 : MAX_FEN_FULL_MOVES, counter))
+			return false;
+
+		fenString = remainingFields;
 	}
 
-	// set castle privileges 
-	for (int character = 0; character < dataVec[FenDataFields::CASTLE_PRIVILEGES].size(); character++)
+	// some programs write a full move number of 0, which is treated as the first move
+	fullMoves = std::max(fullMoves, 1);
+
+	// whatever is left over is the list of EPD operations (such as "bm e4; id \"position 1\";")
+	if (epdOperations)
 	{
-		if		(dataVec[FenDataFields::CASTLE_PRIVILEGES][character] == 'k') currentPosition.castlePrivileges |= (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE;
-		else if (dataVec[FenDataFields::CASTLE_PRIVILEGES][character] == 'q') currentPosition.castlePrivileges |= (Byte)CastlingPrivilege::BLACK_LONG_CASTLE;
-		else if (dataVec[FenDataFields::CASTLE_PRIVILEGES][character] == 'K') currentPosition.castlePrivileges |= (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE;
-		else if (dataVec[FenDataFields::CASTLE_PRIVILEGES][character] == 'Q') currentPosition.castlePrivileges |= (Byte)CastlingPrivilege::WHITE_LONG_CASTLE;
+		size_t operationsStart = std::min(fenString.find_first_not_of(FEN_FIELD_SEPARATORS), fenString.size());
+		size_t operationsEnd   = fenString.find_last_not_of(FEN_FIELD_SEPARATORS) + 1;
+		*epdOperations = fenString.substr(operationsStart, std::max(operationsStart, operationsEnd) - operationsStart);
 	}
 
-	// set en passant square
-	if (dataVec[FenDataFields::EN_PASSANT_SQUARE] != "-")
-		currentPosition.enPassantSquare = getSquareNumberCoordinate(dataVec[FenDataFields::EN_PASSANT_SQUARE]);
+	position.fiftyMoveCounter = fiftyMoveCounter;
+	currentPosition = position;
 
-	// set the number of moves
-	currentPosition.fiftyMoveCounter = std::stoi(dataVec[FenDataFields::FIFTY_MOVE_COUNTER]);
+	// the moves before the position are not known, so the ply starts again from 0 (or 1 if black is to move, so that the ply is always even
+	// when white is to move). the plies played before it are kept, so that the full move number can be written back out by getFEN
+	mPly 	   = (currentPosition.sideToMove == SIDE_WHITE) ? 0 : 1;
+	mPlyOffset = 2 * (fullMoves - 1);
 
-	// set the current ply
-	mPly += 2 * std::stoi(dataVec[FenDataFields::NUM_FULL_MOVES]);
+	// the positions before the one in the FEN string are not known, so clear the keys of whatever game was on the board before
+	// (otherwise the threefold repetition check would compare against positions from that game)
+	for (int ply = 0; ply < mPly; ply++)
+		mZobristKeyHistory[ply] = 0;
 
-	// set the bits on all other additional bitboards for the current position (like the occupied bitboard or the white pieces bitboard)
-	initializeAuxillaryBitboards();
+	computeScores(currentPosition);
+	currentPosition.pawnKey = ZobristKey::generatePawnKey(&currentPosition);
 
 	// generate a new zobrist key based off of the position and insert it into the position history at the current ply
 	mCurrentZobristKey = ZobristKey::generate(&currentPosition);
 	insertMoveIntoHistory(mPly);
+
+	if (mIncrementalAttacks)
+		resetIncrementalAttacks();
+
+	return true;
+}
+
+// writes the position on the board out as a FEN string. without the move counters, this is the four fields that an EPD string starts with
+std::string Board::getFEN(bool includeMoveCounters)
+{
+	// the string is written into a buffer on the stack, so that the only memory allocated is for the string that is returned
+	char fen[MAX_FEN_LENGTH];
+	char* fenEnd = fen;
+
+	// the ranks are written from the eighth rank down, with a number for each run of empty squares
+	for (int rank = 7; rank >= 0; rank--)
+	{
+		int emptySquares = 0;
+		for (int file = 0; file < 8; file++)
+		{
+			Byte square 	= rank * 8 + file;
+			PieceType piece = currentPosition.pieces[square];
+			if (piece == NO_PIECE)
+			{
+				emptySquares++;
+				continue;
+			}
+
+			if (emptySquares > 0)
+				*fenEnd++ = '0' + emptySquares;
+			emptySquares = 0;
+
+			Colour side = (currentPosition.blackPiecesBB & BB::boardSquares[square]) ? SIDE_BLACK : SIDE_WHITE;
+			*fenEnd++ = FEN_PIECE_CHARACTERS[side][piece];
+		}
+
+		if (emptySquares > 0)
+			*fenEnd++ = '0' + emptySquares;
+		if (rank > 0)
+			*fenEnd++ = '/';
+	}
+
+	*fenEnd++ = ' ';
+	*fenEnd++ = (currentPosition.sideToMove == SIDE_WHITE) ? 'w' : 'b';
+
+	*fenEnd++ = ' ';
+	if (!currentPosition.castlePrivileges)
+		*fenEnd++ = '-';
+	for (const FENCastlePrivilege& castle : fenCastlePrivileges)
+		if (currentPosition.castlePrivileges & (Byte)castle.privilege)
+			*fenEnd++ = castle.character;
+
+	*fenEnd++ = ' ';
+	if (currentPosition.enPassantSquare == NO_SQUARE)
+		*fenEnd++ = '-';
+	else
+	{
+		*fenEnd++ = 'a' + currentPosition.enPassantSquare % 8;
+		*fenEnd++ = '1' + currentPosition.enPassantSquare / 8;
+	}
+
+	if (includeMoveCounters)
+	{
+		// the numbers are written after the space before them, and the space is only written once the number is known to have fit (the
+		// buffer is long enough for any counters the board can have, but this keeps every write within it)
+		char* const fenLimit = fen + MAX_FEN_LENGTH;
+		for (int counter : { (int)currentPosition.fiftyMoveCounter, (mPlyOffset + mPly) / 2 + 1 })
+		{
+			if (fenEnd == fenLimit)
+				break;
+
+			auto [counterEnd, error] = std::to_chars(fenEnd + 1, fenLimit, counter);
+			if (error != std::errc())
+				break;
+
+			*fenEnd = ' ';
+			fenEnd  = counterEnd;
+		}
+	}
+
+	return std::string(fen, fenEnd);
 }
 
 // make a move formatted long algebraic notation (for uci purposes)
 bool Board::makeMoveLAN(const std::string& lanString)
 {
-	// disect the LAN string into a string for the origin square and the target square
-	std::string from(lanString.begin(), lanString.begin() + 2);
-	std::string to(lanString.begin() + 2, lanString.begin() + 4);
+	// disect the LAN string into the coordinates of the origin square and the target square, and convert them into number coordinates
+	Byte moveOriginSquare = getSquareNumberCoordinate(std::string_view(lanString).substr(0, 2));
+	Byte moveTargetSquare = getSquareNumberCoordinate(std::string_view(lanString).substr(2, 2));
 
-	// convert the above strings into number coordinates
-	Byte moveOriginSquare = getSquareNumberCoordinate(from);
-	Byte moveTargetSquare = getSquareNumberCoordinate(to);
+	// if there is a fifth character in the lan move string, then it means a pawn is promoting (and the character says to what)
+	MoveType promotionType = MoveType::QUEEN_PROMO;
+	if (lanString.size() > 4)
+	{
+		char lastCharacter = lanString[4];
+		if		(lastCharacter == 'r') promotionType = MoveType::ROOK_PROMO;
+		else if (lastCharacter == 'n') promotionType = MoveType::KNIGHT_PROMO;
+		else if (lastCharacter == 'b') promotionType = MoveType::BISHOP_PROMO;
+	}
 
-	// populate a vector with all the possible moves
-	std::vector<MoveData> moveVec;
-	MoveGeneration::calculatePieceMoves(this, currentPosition.sideToMove, moveOriginSquare, moveVec, false);
-	if (from == "e1" || from == "e8")
-		MoveGeneration::calculateCastleMoves(this, currentPosition.sideToMove, moveVec);
+	// populate a move list with all the legal moves (so any move that matches can be made without checking it any further)
+	MoveList moveList;
+	MoveGeneration::calculateSideMoves(this, currentPosition.sideToMove, moveList);
 
 	// iterate over all the moves and compare the origin/target squares of the move provided with the origin/target squares of the
-	// possible moves at that square (plus potential castle moves) if there's a match, then make the move
-	for (int i = 0; i < moveVec.size(); i++)
-		if (moveVec[i].originSquare == moveOriginSquare && moveVec[i].targetSquare == moveTargetSquare)
+	// legal moves. if there's a match, then make the move
+	for (int i = 0; i < moveList.size(); i++)
+	{
+		Move move = moveList[i].move;
+		if (move.originSquare() == moveOriginSquare && move.targetSquare() == moveTargetSquare && 
+			(!move.isPromotion() || move.moveType() == promotionType))
 		{
-			makeMove(&moveVec[i]);
-			char lastCharacter = lanString.back();
-
-			// if the last character in the lan move string is a character, then it means a pawn has promoted
-			if (lastCharacter > ASCII::LETTER_A_CODE)
-			{
-				if		(lastCharacter == 'q') promotePiece(&moveVec[i], MoveType::QUEEN_PROMO);
-				else if (lastCharacter == 'r') promotePiece(&moveVec[i], MoveType::ROOK_PROMO);
-				else if (lastCharacter == 'n') promotePiece(&moveVec[i], MoveType::KNIGHT_PROMO);
-				else if (lastCharacter == 'b') promotePiece(&moveVec[i], MoveType::BISHOP_PROMO);
-			}
-
+			makeMove(move);
 			return true;
 		}
+	}
 
 	return false;
 }
 
 // convert the engine's move data structure into a LAN string (excluding the type of piece at the start of the string, as uci 
 // does not require it, while including the promotion of the pawn should it be needed)
-std::string Board::getMoveLANString(MoveData* moveData)
+std::string Board::getMoveLANString(Move move)
 {
-	std::string lanString = getSquareStringCoordinate(moveData->originSquare) + getSquareStringCoordinate(moveData->targetSquare);
+	std::string lanString = getSquareStringCoordinate(move.originSquare()) + getSquareStringCoordinate(move.targetSquare());
 
-	if		(moveData->moveType == MoveType::QUEEN_PROMO)  lanString += "q";
-	else if (moveData->moveType == MoveType::ROOK_PROMO)   lanString += "r";
-	else if (moveData->moveType == MoveType::KNIGHT_PROMO) lanString += "n";
-	else if (moveData->moveType == MoveType::BISHOP_PROMO) lanString += "b";
+	if		(move.moveType() == MoveType::QUEEN_PROMO)  lanString += "q";
+	else if (move.moveType() == MoveType::ROOK_PROMO)   lanString += "r";
+	else if (move.moveType() == MoveType::KNIGHT_PROMO) lanString += "n";
+	else if (move.moveType() == MoveType::BISHOP_PROMO) lanString += "b";
 
 	return lanString;
 }
 
-// initialize the bitboards and move generator tables
-void Board::init()
+// finds the squares of the rook before and after a castle
+void getCastleRookSquares(Move move, Byte* rookOriginSquare, Byte* rookTargetSquare)
 {
-	BB::initialize();
-	MoveGeneration::init();
+	if (move.moveType() == MoveType::SHORT_CASTLE)
+	{
+		*rookOriginSquare = move.originSquare() + 3;
+		*rookTargetSquare = move.targetSquare() - 1;
+	}
+	else
+	{
+		*rookOriginSquare = move.originSquare() - 4;
+		*rookTargetSquare = move.targetSquare() + 1;
+	}
 }
 
-// set some data (origin/target square, colour bitboard, and piece bitboard) of the two moves
-// that are made during a castle move (to the engine, it is like the rook and the king both move on the same turn)
-void Board::setCastleMoveData(MoveData* castleMoveData, MoveData* kingMD, MoveData* rookMD)
+// moves both the king and the rook involved in a castle. like updateBitboardWithMove, calling this a second
+// time with the same move will put the pieces back where they were
+void Board::updateBitboardWithCastle(Move move)
 {
-	kingMD->originSquare = castleMoveData->originSquare;
-	kingMD->targetSquare = castleMoveData->targetSquare;
-	rookMD->moveType = MoveType::CASTLE_HALF_MOVE;
-	kingMD->moveType = MoveType::CASTLE_HALF_MOVE;
+	Byte rookOriginSquare, rookTargetSquare;
+	getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
 
-    if (castleMoveData->side == SIDE_WHITE)
-    {
-        kingMD->pieceBB  = &currentPosition.whiteKingBB;
-        kingMD->colourBB = &currentPosition.whitePiecesBB;
+	Bitboard kingMoveBB = BB::boardSquares[move.originSquare()] ^ BB::boardSquares[move.targetSquare()];
+	Bitboard rookMoveBB = BB::boardSquares[rookOriginSquare] ^ BB::boardSquares[rookTargetSquare];
 
-        rookMD->pieceBB  = &currentPosition.whiteRooksBB;
-        rookMD->colourBB = &currentPosition.whitePiecesBB;
-    }
-    else // the move is from the black side
-    {
-        kingMD->pieceBB  = &currentPosition.blackKingBB;
-        kingMD->colourBB = &currentPosition.blackPiecesBB;
+	currentPosition.getPieceBB(move.side(), KING) ^= kingMoveBB;
+	currentPosition.getPieceBB(move.side(), ROOK) ^= rookMoveBB;
+	currentPosition.getColourBB(move.side())	  ^= kingMoveBB | rookMoveBB;
 
-        rookMD->pieceBB  = &currentPosition.blackRooksBB;
-        rookMD->colourBB = &currentPosition.blackPiecesBB;
-    }
+	currentPosition.occupiedBB ^= kingMoveBB | rookMoveBB;
+	currentPosition.emptyBB	   ^= kingMoveBB | rookMoveBB;
 }
 
-// if the castle move is legal, this function will make 2 moves that will mimic a castle move (by moving the king and the rook in one move)
-bool Board::makeCastleMove(MoveData* md)
+// after a move, use bitwise operators to set or unset the appropriate bits in the bitboards affected by the move
+void Board::updateBitboardWithMove(Move move)
 {
-    static MoveData kingMove;
-    static MoveData rookMove;
-
-	// sets the origin/target square, colour bitboard, and piece bitboard of the two "half" moves
-    setCastleMoveData(md, &kingMove, &rookMove);
+	Colour side = move.side();
 
-    if (md->moveType == MoveType::SHORT_CASTLE)
-    {
-        // prevent castling if squares are under attack (preventing a caslte)
-        for (int square = 0; square <= 2; square++)
-            if (squareAttacked(md->originSquare + square, !md->side))
-                return false;
-        
-        rookMove.originSquare = md->originSquare + 3;
-        rookMove.targetSquare = md->targetSquare - 1;
-    }
-    else if (md->moveType == MoveType::LONG_CASTLE)
-    {
-        // prevent castling if squares are under attack (preventing a castle)
-        for (int square = 0; square <= 2; square++)
-            if (squareAttacked(md->originSquare - square, !md->side)) // if attackTable[squrea] & BB::boardsquares[square] ?
-                return false;
-        
-        rookMove.originSquare = md->originSquare - 4;
-        rookMove.targetSquare = md->targetSquare + 1;
-    }
-    else
-        return false;
+	Bitboard originBB = BB::boardSquares[move.originSquare()];
+	Bitboard targetBB = BB::boardSquares[move.targetSquare()];
+	Bitboard originTargetBB = originBB ^ targetBB; // 1 on from and to, 0 on everything else
 
-	// if this function is being called by unmake move (can tell by checking if the rook is not on the corner squares),
-	// then call the appropriate make/unmake move function
-	if (BB::boardSquares[rookMove.targetSquare] & *rookMove.pieceBB)
-	{
-		unmakeMove(&kingMove);
-		unmakeMove(&rookMove);
-		return true;
-	}
-	else // otherwise, make the move as normal
+	// unsets the origin square and sets the target square
+	// a promoting pawn leaves its origin square as a pawn, but arrives at its target square as the piece it promotes to
+	if (move.isPromotion())
 	{
-		makeMove(&kingMove);
-		makeMove(&rookMove);
+		currentPosition.getPieceBB(side, PAWN) 					  ^= originBB;
+		currentPosition.getPieceBB(side, move.promotionPiece()) ^= targetBB;
 	}
+	else
+		currentPosition.getPieceBB(side, move.piece()) ^= originTargetBB;
 
-    return true;
-}
-
-// after a move, use bitwise operators to set or unset the appropriate bits in the bitboards affected by the move
-void Board::updateBitboardWithMove(MoveData* moveData)
-{
-	Bitboard originBB = BB::boardSquares[moveData->originSquare];
-	Bitboard targetBB = BB::boardSquares[moveData->targetSquare];
-	Bitboard originTargetBB = originBB ^ targetBB; // 1 on from and to, 0 on everything else
-
-	// unsets the origin square and sets the target square
-	*moveData->pieceBB  ^= originTargetBB;
-	*moveData->colourBB ^= originTargetBB;
+	currentPosition.getColourBB(side) ^= originTargetBB;
 
-	if (moveData->capturedPieceBB) // if a piece was captured
+	if (move.isCapture()) // if a piece was captured
 	{
-		if (moveData->moveType != MoveType::EN_PASSANT_CAPTURE)
+		Bitboard& capturedPieceBB  = currentPosition.getPieceBB(!side, move.capturedPiece());
+		Bitboard& capturedColourBB = currentPosition.getColourBB(!side);
+
+		if (move.moveType() != MoveType::EN_PASSANT_CAPTURE)
 		{
 			// unset the bit that was captured
-			*moveData->capturedPieceBB  ^= targetBB;
-			*moveData->capturedColourBB ^= targetBB; 
+			capturedPieceBB  ^= targetBB;
+			capturedColourBB ^= targetBB; 
 
 			// the origin square is now empty. we do not XOR the target square, however, as it was previously occupied so to XOR it would unset the bit
 			currentPosition.occupiedBB  ^= originBB;
@@ -313,15 +573,15 @@ void Board::updateBitboardWithMove(MoveData* moveData)
 		else // the move was an en passant capture
 		{
 			// as the target square is not actually the location of the piece for an en passant capture, we need to find the square of the victim
-			Bitboard capturedPieceBB = moveData->side == SIDE_WHITE ? (BB::southOne(targetBB)) : (BB::northOne(targetBB));
+			Bitboard victimBB = side == SIDE_WHITE ? (BB::southOne(targetBB)) : (BB::northOne(targetBB));
 
 			// unset the bit that was captured
-			*moveData->capturedPieceBB  ^= capturedPieceBB;
-			*moveData->capturedColourBB ^= capturedPieceBB;
+			capturedPieceBB  ^= victimBB;
+			capturedColourBB ^= victimBB;
 
 			// unset the bit for the origin square, the square of the captured piece, and fill in the en passant square
-			currentPosition.occupiedBB ^= originBB | capturedPieceBB | targetBB; 
-			currentPosition.emptyBB	   ^= originBB | capturedPieceBB | targetBB;
+			currentPosition.occupiedBB ^= originBB | victimBB | targetBB; 
+			currentPosition.emptyBB	   ^= originBB | victimBB | targetBB;
 		}
 	}
 	else // not a capture move
@@ -332,6 +592,201 @@ void Board::updateBitboardWithMove(MoveData* moveData)
 	}
 }
 
+// moves the pieces in the position's piece array as the move would. unlike the bitboards, the piece array cannot be
+// updated with XORs, so taking the move back is done by undoPiecesWithMove
+void Board::updatePiecesWithMove(Move move)
+{
+	PieceType* pieces = currentPosition.pieces;
+
+	if (move.isCastle())
+	{
+		Byte rookOriginSquare, rookTargetSquare;
+		getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
+
+		pieces[move.originSquare()] = NO_PIECE;
+		pieces[rookOriginSquare]	= NO_PIECE;
+		pieces[move.targetSquare()] = KING;
+		pieces[rookTargetSquare]	= ROOK;
+		return;
+	}
+
+	// the pawn captured en passant is not on the target square, but one square behind it
+	if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+		pieces[move.side() == SIDE_WHITE ? move.targetSquare() - 8 : move.targetSquare() + 8] = NO_PIECE;
+
+	pieces[move.originSquare()] = NO_PIECE;
+	pieces[move.targetSquare()] = move.isPromotion() ? move.promotionPiece() : move.piece();
+}
+
+// updates the zobrist key with the changes that the move made to the position, rather than generating it again from scratch. the keys
+// of the pieces that moved or were captured, and of the old castle privileges and en passant square, are XORed out, and the new ones XORed in
+// (the state before the move is read from the state history, so this must be called after the move has been saved there)
+void Board::updateZobristKeyWithMove(Move move)
+{
+	Colour side = move.side();
+	auto& pieceHashKeys = ZobristKey::pieceHashKeys;
+	ZobristKey::zkey zobristKey = mCurrentZobristKey;
+
+	if (move.isCastle())
+	{
+		Byte rookOriginSquare, rookTargetSquare;
+		getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
+
+		zobristKey ^= pieceHashKeys[side][KING][move.originSquare()] ^ pieceHashKeys[side][KING][move.targetSquare()] ^
+					  pieceHashKeys[side][ROOK][rookOriginSquare]	 ^ pieceHashKeys[side][ROOK][rookTargetSquare];
+	}
+	else
+	{
+		// a promoting pawn leaves its origin square as a pawn, but arrives on the target square as the piece it promotes to
+		zobristKey ^= pieceHashKeys[side][move.piece()][move.originSquare()] ^
+					  pieceHashKeys[side][move.isPromotion() ? move.promotionPiece() : move.piece()][move.targetSquare()];
+
+		// the pawn captured en passant is not on the target square, but one square behind it
+		if (move.isCapture())
+		{
+			Byte capturedSquare = move.targetSquare();
+			if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+				capturedSquare = side == SIDE_WHITE ? capturedSquare - 8 : capturedSquare + 8;
+
+			zobristKey ^= pieceHashKeys[!side][move.capturedPiece()][capturedSquare];
+		}
+	}
+
+	// the castle privileges and en passant square from before the move are read from wherever the move saved them
+#if ATHENA_COPY_MAKE
+	const ChessPosition& previousState = mPositionStack[mPly].position;
+#else
+	const BoardState& previousState = mStateHistory[mPly];
+#endif
+
+	zobristKey ^= ZobristKey::castleHashKeys[previousState.castlePrivileges] ^ ZobristKey::castleHashKeys[currentPosition.castlePrivileges];
+
+	if (previousState.enPassantSquare != NO_SQUARE)
+		zobristKey ^= ZobristKey::enpassantHashKeys[previousState.enPassantSquare];
+	if (currentPosition.enPassantSquare != NO_SQUARE)
+		zobristKey ^= ZobristKey::enpassantHashKeys[currentPosition.enPassantSquare];
+
+	// the side to move always changes
+	mCurrentZobristKey = zobristKey ^ ZobristKey::sideToPlayHashKey;
+}
+
+// updates the position's pawn key with the pawns that the move moved, captured or promoted. like the bitboards, the pawn key is updated
+// with XORs, so calling this a second time with the same move (when it is unmade) takes the changes back out again
+void Board::updatePawnKeyWithMove(Move move)
+{
+	Colour side = move.side();
+	auto& pawnHashKeys = ZobristKey::pieceHashKeys;
+
+	// a promoting pawn leaves its origin square as a pawn, but does not arrive on the target square as one
+	if (move.piece() == PAWN)
+	{
+		currentPosition.pawnKey ^= pawnHashKeys[side][PAWN][move.originSquare()];
+		if (!move.isPromotion())
+			currentPosition.pawnKey ^= pawnHashKeys[side][PAWN][move.targetSquare()];
+	}
+
+	// the pawn captured en passant is not on the target square, but one square behind it
+	if (move.capturedPiece() == PAWN)
+	{
+		Byte capturedSquare = move.targetSquare();
+		if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+			capturedSquare = side == SIDE_WHITE ? capturedSquare - 8 : capturedSquare + 8;
+
+		currentPosition.pawnKey ^= pawnHashKeys[!side][PAWN][capturedSquare];
+	}
+}
+
+// returns true if both the zobrist key of the position and its pawn key (which are updated as moves are made) match newly generated ones
+bool Board::verifyZobristKey()
+{
+	return mCurrentZobristKey == ZobristKey::generate(&currentPosition) && currentPosition.pawnKey == ZobristKey::generatePawnKey(&currentPosition);
+}
+
+// adds the changes that the move makes to the midgame and endgame scores and the material key of the position (a sign of 1 is used when
+// the move is made, and a sign of -1 takes the same changes away again when the move is unmade)
+void Board::updateScoresWithMove(Move move, int sign)
+{
+	Colour side = move.side();
+	const auto& midgameValues = Eval::midgamePieceSquareValues;
+	const auto& endgameValues = Eval::endgamePieceSquareValues;
+	int midgameChange, endgameChange;
+	int64_t materialKeyChange = 0;
+
+	if (move.isCastle())
+	{
+		Byte rookOriginSquare, rookTargetSquare;
+		getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
+
+		midgameChange = midgameValues[side][KING][move.targetSquare()] - midgameValues[side][KING][move.originSquare()] + 
+						midgameValues[side][ROOK][rookTargetSquare]	   - midgameValues[side][ROOK][rookOriginSquare];
+		endgameChange = endgameValues[side][KING][move.targetSquare()] - endgameValues[side][KING][move.originSquare()] + 
+						endgameValues[side][ROOK][rookTargetSquare]	   - endgameValues[side][ROOK][rookOriginSquare];
+	}
+	else
+	{
+		// a promoting pawn leaves its origin square as a pawn, but arrives on the target square as the piece it promotes to
+		PieceType arrivingPiece = move.isPromotion() ? move.promotionPiece() : move.piece();
+
+		midgameChange = midgameValues[side][arrivingPiece][move.targetSquare()] - midgameValues[side][move.piece()][move.originSquare()];
+		endgameChange = endgameValues[side][arrivingPiece][move.targetSquare()] - endgameValues[side][move.piece()][move.originSquare()];
+		materialKeyChange = Eval::getMaterialKeyIncrement(side, arrivingPiece) - Eval::getMaterialKeyIncrement(side, move.piece());
+
+		// the pawn captured en passant is not on the target square, but one square behind it
+		if (move.isCapture())
+		{
+			Byte capturedSquare = move.targetSquare();
+			if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+				capturedSquare = side == SIDE_WHITE ? capturedSquare - 8 : capturedSquare + 8;
+
+			midgameChange -= midgameValues[!side][move.capturedPiece()][capturedSquare];
+			endgameChange -= endgameValues[!side][move.capturedPiece()][capturedSquare];
+			materialKeyChange -= Eval::getMaterialKeyIncrement(!side, move.capturedPiece());
+		}
+	}
+
+	currentPosition.midgameScore += sign * midgameChange;
+	currentPosition.endgameScore += sign * endgameChange;
+	currentPosition.materialKey  += sign * materialKeyChange;
+}
+
+// returns true if the midgame and endgame scores and the material key kept up to date by the moves match the ones summed up from scratch
+bool Board::verifyScores()
+{
+	ChessPosition position = currentPosition;
+	computeScores(position);
+
+	return position.midgameScore == currentPosition.midgameScore && position.endgameScore == currentPosition.endgameScore && 
+		   position.materialKey == currentPosition.materialKey;
+}
+
+// puts the pieces in the position's piece array back to where they were before the move was made
+void Board::undoPiecesWithMove(Move move)
+{
+	PieceType* pieces = currentPosition.pieces;
+
+	if (move.isCastle())
+	{
+		Byte rookOriginSquare, rookTargetSquare;
+		getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
+
+		pieces[move.targetSquare()] = NO_PIECE;
+		pieces[rookTargetSquare]	= NO_PIECE;
+		pieces[move.originSquare()] = KING;
+		pieces[rookOriginSquare]	= ROOK;
+		return;
+	}
+
+	pieces[move.originSquare()] = move.piece();
+
+	if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+	{
+		pieces[move.targetSquare()] = NO_PIECE;
+		pieces[move.side() == SIDE_WHITE ? move.targetSquare() - 8 : move.targetSquare() + 8] = PAWN;
+	}
+	else
+		pieces[move.targetSquare()] = move.capturedPiece();
+}
+
 // returns the coordinate of the king by number (0-63)
 Byte Board::computeKingSquare(Bitboard kingBB)
 {
@@ -349,158 +804,309 @@ Byte Board::computeKingSquare(Bitboard kingBB)
    for example, bishops and queens can attack on diagonals, so we make a bitboard containing all of the bishops and queens.
    afterwards, we AND this bitboard with the possible diagonal moves from the square being attacked. if the value is > 0, 
    then either a queen or a bishop has a diagonal attack that is hitting the square (so return true)
+
+   the attacking side is a template parameter, so that every piece bitboard and pawn direction below is picked at compile time
 */
+template <Colour attackingSide>
+bool Board::squareAttacked(Byte square)
+{
+	// with incremental attacks, the pieces attacking every square are always known
+	if (mIncrementalAttacks)
+		return mAttacksTo[square] & currentPosition.getColourBB(attackingSide);
+
+	// if the attacks of the side have already been computed at this ply, the answer is simply looked up
+	if (mAttackCache[mPly].filledFlags & (attackingSide == SIDE_WHITE ? AttackCache::WHITE_ATTACKS : AttackCache::BLACK_ATTACKS))
+		return mAttackCache[mPly].attackedBB[attackingSide] & BB::boardSquares[square];
+
+	// a pawn of the attacking side attacks the square if it stands where a pawn of the other side on the square would attack
+	if (MoveGeneration::pawnAttackLookupTable[!attackingSide][square] & currentPosition.getPieceBB(attackingSide, PAWN)) return true;
+
+	if (MoveGeneration::knightLookupTable[square] & currentPosition.getPieceBB(attackingSide, KNIGHT)) return true;
+	if (MoveGeneration::kingLookupTable[square]   & currentPosition.getPieceBB(attackingSide, KING))   return true;
+
+	Bitboard queensBB = currentPosition.getPieceBB(attackingSide, QUEEN);
+	if (MoveGeneration::computePseudoBishopMoves(square, currentPosition.occupiedBB, 0) & (currentPosition.getPieceBB(attackingSide, BISHOP) | queensBB)) return true;
+	if (MoveGeneration::computePseudoRookMoves(square, currentPosition.occupiedBB, 0)   & (currentPosition.getPieceBB(attackingSide, ROOK)   | queensBB)) return true;
+
+	return false;
+}
+
+template bool Board::squareAttacked<SIDE_WHITE>(Byte square);
+template bool Board::squareAttacked<SIDE_BLACK>(Byte square);
+
+// for when the attacking side is only known at runtime (the side is branched on once, rather than for every piece)
 bool Board::squareAttacked(Byte square, Colour attackingSide)
 {
-	Bitboard opPawnsBB = attackingSide == SIDE_WHITE ? currentPosition.whitePawnsBB : currentPosition.blackPawnsBB;
+	return attackingSide == SIDE_WHITE ? squareAttacked<SIDE_WHITE>(square) : squareAttacked<SIDE_BLACK>(square);
+}
 
-	// this gets all of the diagonal attacks of the pawns depending on the side attacking. by clearing the A and H files,
-	// we are preventing the "attack" from overflowing into the file on the opposite end of the board
-	if (attackingSide == SIDE_WHITE)
-	{
-		Bitboard northWestAttacksBB = BB::northWestOne(opPawnsBB & BB::fileClear[BB::FILE_A]);
-		Bitboard northEastAttacksBB = BB::northEastOne(opPawnsBB & BB::fileClear[BB::FILE_H]);
-		if (BB::boardSquares[square] & (northWestAttacksBB | northEastAttacksBB))
-			return true;
-	}
-	else
+/*
+	incremental attacks keep the attacks from and to every square up to date as moves are made, instead of computing them when they are needed.
+	when a move is made, the only pieces whose attacks change are those on the squares that the move changed (the origin and target squares,
+	the square of a pawn captured en passant, and the squares of a castling rook), and the sliders that attacked any of those squares
+	(as their rays are the only ones that could now be blocked or unblocked). only the attacks of those pieces are recomputed
+*/
+
+// returns the squares attacked by the piece on the square (or no squares, if the square is empty)
+Bitboard Board::computeAttacksFrom(Byte square)
+{
+	if (!(currentPosition.occupiedBB & BB::boardSquares[square]))
+		return 0;
+
+	Colour side = (currentPosition.whitePiecesBB & BB::boardSquares[square]) ? SIDE_WHITE : SIDE_BLACK;
+
+	switch (currentPosition.pieces[square])
 	{
-		Bitboard southWestAttacksBB = BB::southWestOne(opPawnsBB & BB::fileClear[BB::FILE_A]);
-		Bitboard southEastAttacksBB = BB::southEastOne(opPawnsBB & BB::fileClear[BB::FILE_H]);
-		if (BB::boardSquares[square] & (southWestAttacksBB | southEastAttacksBB))
-			return true;
+		case PAWN:   return MoveGeneration::pawnAttackLookupTable[side][square];
+		case KNIGHT: return MoveGeneration::knightLookupTable[square];
+		case BISHOP: return MoveGeneration::computePseudoBishopMoves(square, currentPosition.occupiedBB, 0);
+		case ROOK:   return MoveGeneration::computePseudoRookMoves(square, currentPosition.occupiedBB, 0);
+		case QUEEN:  return MoveGeneration::computePseudoQueenMoves(square, currentPosition.occupiedBB, 0);
+		case KING:   return MoveGeneration::kingLookupTable[square];
+		default:     return 0;
 	}
-    
-    Bitboard opKnightsBB = attackingSide == SIDE_WHITE ? currentPosition.whiteKnightsBB : currentPosition.blackKnightsBB;
-    if (MoveGeneration::knightLookupTable[square] & opKnightsBB)                  return true;
-    
-    Bitboard opKingsBB = attackingSide    == SIDE_WHITE ? currentPosition.whiteKingBB : currentPosition.blackKingBB;
-    if (MoveGeneration::kingLookupTable[square] & opKingsBB)                      return true;
-    
-    Bitboard opBishopsQueensBB = attackingSide == SIDE_WHITE ? currentPosition.whiteBishopsBB | currentPosition.whiteQueensBB  
-															 : currentPosition.blackBishopsBB | currentPosition.blackQueensBB;
-    Bitboard friendlyPieces = attackingSide == SIDE_WHITE ? currentPosition.blackPiecesBB : currentPosition.whitePiecesBB;
-    if (MoveGeneration::computePseudoBishopMoves(square, currentPosition.occupiedBB, friendlyPieces) & opBishopsQueensBB) return true;
-    
-    Bitboard opRooksQueens = attackingSide == SIDE_WHITE ? currentPosition.whiteRooksBB | currentPosition.whiteQueensBB  
-														 : currentPosition.blackRooksBB | currentPosition.blackQueensBB;
-    if (MoveGeneration::computePseudoRookMoves(square, currentPosition.occupiedBB, friendlyPieces) & opRooksQueens) return true;
-    
-    return false;
-}
-
-// using the same methods as Board::squareAttacked(), this function returns the value of the least valuable piece attacking the square as well as its piece bitboard
-// it is ordered differently, however, as to make sure the least valuable attackers are considered first
-// the function uses pointer arguments to return data about who the attacker is (how many centipawns they're worth, and the piece bitboard they belong to)
-void Board::getLeastValuableAttacker(Byte square, Colour attackingSide, int* pieceValue, Bitboard** pieceBB, Bitboard* attackingPiecesBB)
+}
+
+// returns the squares whose contents were changed by the move (which are the same whether the move is being made or unmade)
+Bitboard Board::getSquaresChangedByMove(Move move)
 {
-	Bitboard opPawnsBB = attackingSide == SIDE_WHITE ? currentPosition.whitePawnsBB : currentPosition.blackPawnsBB;
+	Bitboard changedSquaresBB = BB::boardSquares[move.originSquare()] | BB::boardSquares[move.targetSquare()];
 
-	// this gets all of the diagonal attacks of the pawns depending on the side attacking. by clearing the A and H files,
-	// we are preventing the "attack" from overflowing into the file on the opposite end of the board
-	if (attackingSide == SIDE_WHITE)
+	if (move.isCastle())
 	{
-		Bitboard northWestAttacksBB = BB::northWestOne(opPawnsBB & BB::fileClear[BB::FILE_A]);
-		Bitboard northEastAttacksBB = BB::northEastOne(opPawnsBB & BB::fileClear[BB::FILE_H]);
+		Byte rookOriginSquare, rookTargetSquare;
+		getCastleRookSquares(move, &rookOriginSquare, &rookTargetSquare);
 
-		*attackingPiecesBB = (northWestAttacksBB | northEastAttacksBB) & BB::boardSquares[square];
-		if (*attackingPiecesBB)
-		{
-			// by shifting the attacks bitboards in the opposite direction, we can get
-			// the bitboard that contains the location of all the pawns attacking the square
-			*attackingPiecesBB = BB::southEastOne(northWestAttacksBB) | BB::southWestOne(northEastAttacksBB);
-			*pieceValue = Eval::PAWN_VALUE;
-			*pieceBB = &currentPosition.whitePawnsBB;
-			return;
-		}
+		changedSquaresBB |= BB::boardSquares[rookOriginSquare] | BB::boardSquares[rookTargetSquare];
 	}
-	else
+	else if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
+		changedSquaresBB |= BB::boardSquares[move.side() == SIDE_WHITE ? move.targetSquare() - 8 : move.targetSquare() + 8];
+
+	return changedSquaresBB;
+}
+
+// computes the attacks from and to every square from scratch
+void Board::resetIncrementalAttacks()
+{
+	for (int square = 0; square < 64; square++)
 	{
-		Bitboard southWestAttacks = BB::southWestOne(opPawnsBB & BB::fileClear[BB::FILE_A]);
-		Bitboard southEastAttacks = BB::southEastOne(opPawnsBB & BB::fileClear[BB::FILE_H]);
+		mAttacksFrom[square] = 0;
+		mAttacksTo[square]   = 0;
+	}
 
-		// by shifting the attacks bitboards in the opposite direction, we can get
-		// the bitboard that contains the location of all the pawns attacking the square
-		*attackingPiecesBB = (southWestAttacks | southEastAttacks) & BB::boardSquares[square];
-		if (*attackingPiecesBB)
-		{
-			*attackingPiecesBB = BB::northEastOne(southWestAttacks) | BB::northWestOne(southEastAttacks);
-			*pieceValue = Eval::PAWN_VALUE;
-			*pieceBB = &currentPosition.blackPawnsBB;
-			return;
-		}
+	updateIncrementalAttacks(currentPosition.occupiedBB);
+}
+
+// recomputes the attacks of the pieces that could have been affected by the squares given changing (the bitboards and the piece array
+// must already hold the new position, while the attack tables must still be those of the position before the change)
+void Board::updateIncrementalAttacks(Bitboard changedSquaresBB)
+{
+	Bitboard slidersBB = currentPosition.whiteBishopsBB | currentPosition.whiteRooksBB | currentPosition.whiteQueensBB |
+						 currentPosition.blackBishopsBB | currentPosition.blackRooksBB | currentPosition.blackQueensBB;
+
+	Bitboard affectedSquaresBB = changedSquaresBB;
+	for (Bitboard squaresBB = changedSquaresBB; squaresBB; )
+		affectedSquaresBB |= mAttacksTo[BB::popLSB(squaresBB)] & slidersBB;
+
+	while (affectedSquaresBB)
+	{
+		Byte square = BB::popLSB(affectedSquaresBB);
+		Bitboard squareBB = BB::boardSquares[square];
+
+		// take away the piece's old attacks, and then put in its new ones
+		for (Bitboard attacksBB = mAttacksFrom[square]; attacksBB; )
+			mAttacksTo[BB::popLSB(attacksBB)] &= ~squareBB;
+
+		mAttacksFrom[square] = computeAttacksFrom(square);
+
+		for (Bitboard attacksBB = mAttacksFrom[square]; attacksBB; )
+			mAttacksTo[BB::popLSB(attacksBB)] |= squareBB;
 	}
+}
 
-	Bitboard* opKnightsBB = attackingSide == SIDE_WHITE ? &currentPosition.whiteKnightsBB : &currentPosition.blackKnightsBB;
-	*attackingPiecesBB = MoveGeneration::knightLookupTable[square] & *opKnightsBB;
-	if (*attackingPiecesBB)
+// turns incremental attacks on or off (when they are turned on, they are computed for the current position from scratch)
+void Board::setIncrementalAttacks(bool enabled)
+{
+	mIncrementalAttacks = enabled;
+
+	if (enabled)
+		resetIncrementalAttacks();
+}
+
+// returns true if the incremental attacks match the attacks of the current position computed from scratch
+// this is a debugging function, and it only makes sense to call it when incremental attacks are on
+bool Board::verifyIncrementalAttacks()
+{
+	for (int square = 0; square < 64; square++)
 	{
-		*pieceValue = Eval::KNIGHT_VALUE;
-		*pieceBB = opKnightsBB;
-		return;
+		if (mAttacksFrom[square] != computeAttacksFrom(square))
+			return false;
+
+		Bitboard attackersBB = 0;
+		for (int attacker = 0; attacker < 64; attacker++)
+			if (computeAttacksFrom(attacker) & BB::boardSquares[square])
+				attackersBB |= BB::boardSquares[attacker];
+
+		if (mAttacksTo[square] != attackersBB)
+			return false;
 	}
 
-	Bitboard friendlyPieces = attackingSide == SIDE_WHITE ? currentPosition.blackPiecesBB : currentPosition.whitePiecesBB;
+	return true;
+}
+
+// returns the legality masks of the current position for the side given, computing them only if they have not been yet at this ply
+const MoveGeneration::LegalityMasks& Board::getLegalityMasks(Colour side)
+{
+	AttackCache& cache = mAttackCache[mPly];
+	Byte flag = side == SIDE_WHITE ? AttackCache::WHITE_LEGALITY_MASKS : AttackCache::BLACK_LEGALITY_MASKS;
 
-	Bitboard* opBishopsBB = attackingSide == SIDE_WHITE ? &currentPosition.whiteBishopsBB : &currentPosition.blackBishopsBB;
-	Bitboard bishopMovesBB = MoveGeneration::computePseudoBishopMoves(square, currentPosition.occupiedBB, friendlyPieces);
-	*attackingPiecesBB = bishopMovesBB & *opBishopsBB;
-	if (*attackingPiecesBB)
+	if (!(cache.filledFlags & flag))
 	{
-		*pieceValue = Eval::BISHOP_VALUE;
-		*pieceBB = opBishopsBB;
-		return;
+		cache.legalityMasks[side] = MoveGeneration::computeLegalityMasks(this, side);
+		cache.filledFlags |= flag;
 	}
 
-	Bitboard* opRooks = attackingSide == SIDE_WHITE ? &currentPosition.whiteRooksBB : &currentPosition.blackRooksBB;
-	Bitboard rookMovesBB = MoveGeneration::computePseudoRookMoves(square, currentPosition.occupiedBB, friendlyPieces);
-	*attackingPiecesBB = rookMovesBB & *opRooks;
-	if (*attackingPiecesBB)
+	return cache.legalityMasks[side];
+}
+
+// computes the squares attacked by each type of piece of the side given (and by all of them together), and stores them in the cache for the current ply
+void Board::fillAttacks(Colour side)
+{
+	AttackCache& cache = mAttackCache[mPly];
+
+	for (int piece : { PAWN, KNIGHT, KING })
 	{
-		*pieceValue = Eval::ROOK_VALUE;
-		*pieceBB = opRooks;
-		return;
+		Bitboard attacksBB = 0;
+		for (Bitboard piecesBB = currentPosition.getPieceBB(side, (PieceType)piece); piecesBB; )
+		{
+			Byte square = BB::popLSB(piecesBB);
+
+			switch (piece)
+			{
+				case PAWN:   attacksBB |= MoveGeneration::pawnAttackLookupTable[side][square]; break;
+				case KNIGHT: attacksBB |= MoveGeneration::knightLookupTable[square];           break;
+				case KING:   attacksBB |= MoveGeneration::kingLookupTable[square];             break;
+			}
+		}
+
+		cache.pieceAttacksBB[side][piece] = attacksBB;
 	}
 
-	Bitboard* opQueens = attackingSide == SIDE_WHITE ? &currentPosition.whiteQueensBB : &currentPosition.blackQueensBB;
-	*attackingPiecesBB = (rookMovesBB | bishopMovesBB) & *opQueens;
-	if (*attackingPiecesBB)
+	// the sliders of each type are filled all at once rather than being looked up one at a time (the rooks and bishops together, then the queens)
+	Bitboard queensBB = currentPosition.getPieceBB(side, QUEEN);
+	Bitboard queenOrthogonalBB, queenDiagonalBB;
+
+	BB::slidingAttacks(currentPosition.getPieceBB(side, ROOK), currentPosition.getPieceBB(side, BISHOP), ~currentPosition.occupiedBB,
+					   &cache.pieceAttacksBB[side][ROOK], &cache.pieceAttacksBB[side][BISHOP]);
+	BB::slidingAttacks(queensBB, queensBB, ~currentPosition.occupiedBB, &queenOrthogonalBB, &queenDiagonalBB);
+
+	cache.pieceAttacksBB[side][QUEEN] = queenOrthogonalBB | queenDiagonalBB;
+
+	cache.attackedBB[side] = cache.pieceAttacksBB[side][PAWN]   | cache.pieceAttacksBB[side][KNIGHT] | cache.pieceAttacksBB[side][BISHOP] | 
+							 cache.pieceAttacksBB[side][ROOK]   | cache.pieceAttacksBB[side][QUEEN]  | cache.pieceAttacksBB[side][KING];
+
+	cache.filledFlags |= side == SIDE_WHITE ? AttackCache::WHITE_ATTACKS : AttackCache::BLACK_ATTACKS;
+}
+
+// returns every square attacked by the side given in the current position
+Bitboard Board::getAttackedSquares(Colour side)
+{
+	if (!(mAttackCache[mPly].filledFlags & (side == SIDE_WHITE ? AttackCache::WHITE_ATTACKS : AttackCache::BLACK_ATTACKS)))
+		fillAttacks(side);
+
+	return mAttackCache[mPly].attackedBB[side];
+}
+
+// returns the squares attacked by the pieces of the type given of the side given in the current position
+Bitboard Board::getPieceAttacks(Colour side, PieceType piece)
+{
+	if (!(mAttackCache[mPly].filledFlags & (side == SIDE_WHITE ? AttackCache::WHITE_ATTACKS : AttackCache::BLACK_ATTACKS)))
+		fillAttacks(side);
+
+	return mAttackCache[mPly].pieceAttacksBB[side][piece];
+}
+
+// using the same methods as Board::squareAttacked(), this function returns the least valuable pieces attacking the square (all of the
+// attacking pieces of the least valuable type), and gives back how many centipawns that type of piece is worth through the pointer argument
+// it is ordered differently, however, as to make sure the least valuable attackers are considered first
+// the pieces in the excluded bitboard are ignored (the static exchange evaluation uses this for the pieces that have already captured)
+// the cached attacks of each type of piece are checked first, so that the attackers of a type are only looked for if that type attacks the square at all
+template <Colour attackingSide>
+Bitboard Board::getLeastValuableAttackers(Byte square, Bitboard excludedBB, int* pieceValue)
+{
+	// with incremental attacks, the attackers of the square are already known, and only have to be sorted by type
+	if (mIncrementalAttacks)
 	{
-		*pieceValue = Eval::QUEEN_VALUE;
-		*pieceBB = opQueens;
-		return;
+		Bitboard attackersBB = mAttacksTo[square] & ~excludedBB;
+
+		for (int piece = PAWN; piece <= KING; piece++)
+		{
+			Bitboard attackingPiecesBB = attackersBB & currentPosition.getPieceBB(attackingSide, (PieceType)piece);
+			if (attackingPiecesBB)
+			{
+				*pieceValue = Eval::PIECE_VALUES[piece];
+				return attackingPiecesBB;
+			}
+		}
+
+		return 0;
 	}
 
-	Bitboard* opKingsBB = attackingSide == SIDE_WHITE ? &currentPosition.whiteKingBB : &currentPosition.blackKingBB;
-	*attackingPiecesBB = MoveGeneration::kingLookupTable[square] & *opKingsBB;
-	if (*attackingPiecesBB)
+	Bitboard squareBB = BB::boardSquares[square];
+	if (!(getAttackedSquares(attackingSide) & squareBB))
+		return 0;
+
+	for (int piece = PAWN; piece <= KING; piece++)
 	{
-		*pieceValue = Eval::KING_VALUE;
-		*pieceBB = opKingsBB;
-		return;
+		if (!(mAttackCache[mPly].pieceAttacksBB[attackingSide][piece] & squareBB))
+			continue;
+
+		// the pieces of this type that attack the square are those that a piece of the same type on the square would attack
+		Bitboard attacksFromSquareBB;
+		switch (piece)
+		{
+			case PAWN:   attacksFromSquareBB = MoveGeneration::pawnAttackLookupTable[!attackingSide][square];                   break;
+			case KNIGHT: attacksFromSquareBB = MoveGeneration::knightLookupTable[square];                                       break;
+			case BISHOP: attacksFromSquareBB = MoveGeneration::computePseudoBishopMoves(square, currentPosition.occupiedBB, 0); break;
+			case ROOK:   attacksFromSquareBB = MoveGeneration::computePseudoRookMoves(square, currentPosition.occupiedBB, 0);   break;
+			case QUEEN:  attacksFromSquareBB = MoveGeneration::computePseudoQueenMoves(square, currentPosition.occupiedBB, 0);  break;
+			default:     attacksFromSquareBB = MoveGeneration::kingLookupTable[square];                                         break;
+		}
+
+		Bitboard attackingPiecesBB = attacksFromSquareBB & currentPosition.getPieceBB(attackingSide, (PieceType)piece) & ~excludedBB;
+		if (attackingPiecesBB)
+		{
+			*pieceValue = Eval::PIECE_VALUES[piece];
+			return attackingPiecesBB;
+		}
 	}
+
+	return 0;
 }
 
+template Bitboard Board::getLeastValuableAttackers<SIDE_WHITE>(Byte square, Bitboard excludedBB, int* pieceValue);
+template Bitboard Board::getLeastValuableAttackers<SIDE_BLACK>(Byte square, Bitboard excludedBB, int* pieceValue);
+
 // if the move made generated an en passant square, set the current en passant square for the current position
-void Board::setEnPassantSquares(MoveData* moveData)
+void Board::setEnPassantSquares(Move move)
 {
 	// default to no en passant squares being set
 	currentPosition.enPassantSquare = NO_SQUARE;
 
-	// the below if statements check to see if the move would have set an en passant square by checking if the piece
-	// moved was a pawn, and if so, if it moved 2 spaces (8 tiles * 2 = 16). if it passes, it will set the coordinate
-	// of the en passant square to the correct value for the current position
+	// the below if statement checks to see if the move would have set an en passant square by checking if the piece
+	// moved was a pawn, and if so, if it moved 2 spaces (8 tiles * 2 = 16) in either direction. if it passes, the en passant
+	// square is the one that the pawn skipped over (halfway between its origin and target), which works the same for both sides
 
-	if (moveData->pieceBB == &currentPosition.whitePawnsBB && moveData->targetSquare - moveData->originSquare == 16)
-		currentPosition.enPassantSquare = moveData->targetSquare - 8;
-	else if (moveData->pieceBB == &currentPosition.blackPawnsBB && moveData->originSquare - moveData->targetSquare == 16)
-		currentPosition.enPassantSquare = moveData->targetSquare + 8;
+	if (move.piece() == PAWN && (move.targetSquare() - move.originSquare() == 16 || move.originSquare() - move.targetSquare() == 16))
+		currentPosition.enPassantSquare = (move.originSquare() + move.targetSquare()) / 2;
 }
 
 // adds the current position's zobrist key into the game's position history 
+// as this is a new position at the ply, the attacks cached for the ply's previous position are thrown out as well
 void Board::insertMoveIntoHistory(short ply)
 {
 	mZobristKeyHistory[ply] = mCurrentZobristKey;
+	mAttackCache[ply].filledFlags = 0;
 }
 
 // removes the current position's zobrist key from the game's position history
@@ -510,191 +1116,147 @@ void Board::deleteMoveFromHistory(short ply)
 }
 
 /* 
-    using the information in the MoveData struct, this functions performs the following:
+    using the information in the Move, this functions performs the following:
 		update the bitboards affected in the move
-		check legality of the move (i.e. if it would result in a check)
+		update the midgame and endgame scores, the material key and the pawn key
+		save the state of the position that the move cannot restore on its own (with copy-make, the whole position is saved instead)
 		update castle privileges
 		set any en passant squares, update the fifty move counter, and change the side to move
-		insert the move into the position history (unless it was one of the two castle moves making up the whole move)
+		insert the move into the position history
+
+	the move must be legal (which every move from MoveGeneration is), as its legality is not checked here
 */
-bool Board::makeMove(MoveData* moveData)
+void Board::makeMove(Move move)
 {
+#if ATHENA_COPY_MAKE
+	// the position is saved before the move changes it, so that unmaking the move only has to copy it back
+	mPositionStack[mPly].position = currentPosition;
+#endif
+
 	// check to see if the move was a castling move
-	if (moveData->moveType == MoveType::SHORT_CASTLE || moveData->moveType == MoveType::LONG_CASTLE)
-	{
-		if (!makeCastleMove(moveData))
-			return false;
-	}
+	if (move.isCastle())
+		updateBitboardWithCastle(move);
 	else
-	{
-		updateBitboardWithMove(moveData);
+		updateBitboardWithMove(move);
 
-		// checking to see if the king is in check (if it is, then the move would be illegal)
-		Byte kingSquare = computeKingSquare(moveData->side == SIDE_WHITE ? currentPosition.whiteKingBB : currentPosition.blackKingBB);
-		if (squareAttacked(kingSquare, !moveData->side) || kingSquare == 255) // kingSquare == 255 means that there is no king on the board
-		{
-			// passing in false so that we do not update the zobrist key/history, as we never actually added it here
-			// this means that otherwise it would be removing the previous zobrist key, eventually giving negative 
-			// ply numbers and undefined behaviour
+	updatePiecesWithMove(move);
+	updateScoresWithMove(move, 1);
+	updatePawnKeyWithMove(move);
 
-			moveData->fiftyMoveCounter = currentPosition.fiftyMoveCounter;
-			unmakeMove(moveData, false);
-			return false;
-		}
-	}
+	if (mIncrementalAttacks)
+		updateIncrementalAttacks(getSquaresChangedByMove(move));
 
-	// if the move was legal, then account for all the changes to the current position that the move could have had
+	// account for all the changes to the current position that the move could have had
 	// en passant squares, castle privileges, drawing conditions, side to move, etc
+	// the values before the move are saved first, so that they can be restored when the move is unmade (with copy-make, they
+	// are already in the copy of the position)
 
-	setEnPassantSquares(moveData);
-
-	// update the castle privileges after the move
-	currentPosition.castlePrivileges &= ~moveData->castlePrivilegesRevoked;
+#if !ATHENA_COPY_MAKE
+	mStateHistory[mPly] = { currentPosition.castlePrivileges, currentPosition.enPassantSquare, currentPosition.fiftyMoveCounter };
+#endif
 
-	// when a castle move occurs, two moves are actually made (meaning that this function is called twice)
-	// however, one of those moves is designated as a castle half move, meaning that it doesn't cause any changes
-	// to the state of the current position, other than updating the bitboards and the current position's zobrist
-	// key. the other move, however, is not designated as such, and will cause the below if statement to pass,
-	// thereby updating all the rest of the data it needs to
-	if (moveData->moveType != MoveType::CASTLE_HALF_MOVE)
-	{
-		// update the fifty move counter drawing condition
-		moveData->fiftyMoveCounter = currentPosition.fiftyMoveCounter;
+	setEnPassantSquares(move);
 
-		// reset the fifty move counter if there was a capture or a pawn advance, otherwise increment it
-		if (moveData->capturedPieceBB || moveData->pieceBB == &currentPosition.whitePawnsBB || moveData->pieceBB == &currentPosition.blackPawnsBB)
-			currentPosition.fiftyMoveCounter = 0;
-		else
-			currentPosition.fiftyMoveCounter++;
+	// update the castle privileges after the move
+	currentPosition.castlePrivileges &= ~(castlePrivilegesRevokedBySquare[move.originSquare()] | castlePrivilegesRevokedBySquare[move.targetSquare()]);
 
-		currentPosition.sideToMove = !currentPosition.sideToMove;
+	// reset the fifty move counter if there was a capture or a pawn advance, otherwise increment it
+	if (move.isCapture() || move.piece() == PAWN)
+		currentPosition.fiftyMoveCounter = 0;
+	else
+		currentPosition.fiftyMoveCounter++;
 
-		mCurrentZobristKey = ZobristKey::generate(&currentPosition);
+	currentPosition.sideToMove = !currentPosition.sideToMove;
 
-		insertMoveIntoHistory(++mPly);
-	} 
+	updateZobristKeyWithMove(move);
 
-	return true;
+	insertMoveIntoHistory(++mPly);
 }
 
 /*
-	using the information in the MoveData struct, this functions takes a move back. It does so by:
-		undoing any pawn promotions
-		updating the bitboards that were affected in the move
-		reseting en passant squares, castle privileges, side to move, and fifty move counter by using the values stored in the move data
+	using the information in the Move, this functions takes a move back. It does so by:
+		updating the bitboards that were affected in the move (including undoing any pawn promotions)
+		taking the move's changes back out of the midgame and endgame scores, the material key and the pawn key
+		reseting en passant squares, castle privileges, and fifty move counter by using the board state saved when the move was made
 		deleting the move from the position history
+	when copy-make is on, the bitboards, piece array, scores, keys and board state are instead restored by copying back the position saved
+	when the move was made. the zobrist key comes back from the position history and the incremental attacks (which are kept outside the
+	position) are undone square by square, in the same way for both
 */
-bool Board::unmakeMove(MoveData* moveData, bool positionUpdated)
+void Board::unmakeMove(Move move)
 {
-	// if the move we're unmaking was a castle move, then we want to undo the castle move by calling the make castle move function
-	// this function checks to see if we're unmaking the castle move or not, and so it handles all the necessary function calls
-	// to properly undo the castle move
-	if (moveData->moveType == MoveType::SHORT_CASTLE || moveData->moveType == MoveType::LONG_CASTLE)
-		makeCastleMove(moveData);
+#if ATHENA_COPY_MAKE
+	// the position from before the move was made is simply copied back from the stack
+	currentPosition = mPositionStack[mPly - 1].position;
+
+	if (mIncrementalAttacks)
+		updateIncrementalAttacks(getSquaresChangedByMove(move));
+
+	mCurrentZobristKey = mZobristKeyHistory[mPly - 1];
+	deleteMoveFromHistory(mPly--);
+#else
+	// update the bitboards so that they are as they were before the move was made this can
+	// simply be done by calling the exact same function that made the move in the first place
+	if (move.isCastle())
+		updateBitboardWithCastle(move);
 	else
-	{
-		// if a promotion occured during the move, then undo whatever promotion occured
-		undoPromotion(moveData);
+		updateBitboardWithMove(move);
 
-		// update the bitboards so that they are as they were before the move was made this can
-		// simply be done by calling the exact same function that made the move in the first place
-		updateBitboardWithMove(moveData);
-	}
+	undoPiecesWithMove(move);
+	updateScoresWithMove(move, -1);
+	updatePawnKeyWithMove(move);
 
-	// as described in Board::makeMove, a castling move consists of two actual pieces moving
-	// one of them will be designated as a move that shouldn't cause updates (if it has moveType = CASTLE_HALF_MOVE)
-	// as such, should a castle move have occured, the below if statement will only pass once, even though
-	// resetting the castle move will cause two separate moves
-	if (moveData->moveType != MoveType::CASTLE_HALF_MOVE && positionUpdated)
-	{
-		// reset the zobrist key to the previus position's
-		mCurrentZobristKey = mZobristKeyHistory[mPly - 1];
+	if (mIncrementalAttacks)
+		updateIncrementalAttacks(getSquaresChangedByMove(move));
 
-		// reset all of the data as it was before the move was made
-		currentPosition.enPassantSquare   = moveData->enPassantSquare;
-		currentPosition.castlePrivileges ^= moveData->castlePrivilegesRevoked;
-		currentPosition.fiftyMoveCounter  = moveData->fiftyMoveCounter;
-		currentPosition.sideToMove 		  = !currentPosition.sideToMove;
+	// reset the zobrist key to the previus position's
+	mCurrentZobristKey = mZobristKeyHistory[mPly - 1];
 
-		// remove the current position from the position history
-		deleteMoveFromHistory(mPly--);
-	}
+	// reset all of the data as it was before the move was made
+	const BoardState& previousState = mStateHistory[mPly - 1];
+	currentPosition.enPassantSquare  = previousState.enPassantSquare;
+	currentPosition.castlePrivileges = previousState.castlePrivileges;
+	currentPosition.fiftyMoveCounter = previousState.fiftyMoveCounter;
+	currentPosition.sideToMove 		 = !currentPosition.sideToMove;
 
-	return true;
+	// remove the current position from the position history
+	deleteMoveFromHistory(mPly--);
+#endif
 }
 
-// replaces the promoted pawn back to a pawn and removes the piece the pawn promoted to from its respective bitboard
-void Board::undoPromotion(MoveData* moveData)
+/*
+	passes the turn to the other side without moving any pieces (this is used by the search's null move pruning). it does so by:
+		saving the state of the position, as makeMove does
+		clearing the en passant square (the other side cannot capture en passant after a null move)
+		updating the fifty move counter and changing the side to move
+		updating the zobrist key and inserting it into the position history
+	no pieces move, so the scores and the incremental attacks stay as they are (and copy-make has nothing to copy)
+*/
+void Board::makeNullMove()
 {
-	// places the pawn back to its previous position
-	if (moveData->moveType == MoveType::BISHOP_PROMO || moveData->moveType == MoveType::ROOK_PROMO ||
-		moveData->moveType == MoveType::KNIGHT_PROMO || moveData->moveType == MoveType::QUEEN_PROMO)
-	{
-		if (moveData->side == SIDE_WHITE) currentPosition.whitePawnsBB ^= BB::boardSquares[moveData->targetSquare];
-		else							  currentPosition.blackPawnsBB ^= BB::boardSquares[moveData->targetSquare];
-	}
-	else
-		return;
+	mStateHistory[mPly] = { currentPosition.castlePrivileges, currentPosition.enPassantSquare, currentPosition.fiftyMoveCounter };
 
-	// removes the piece that the pawn promoted to
-	switch (moveData->moveType)
-	{
-		case MoveType::QUEEN_PROMO:
-		{
-			if (moveData->side == SIDE_WHITE) currentPosition.whiteQueensBB ^= BB::boardSquares[moveData->targetSquare];
-			else							  currentPosition.blackQueensBB ^= BB::boardSquares[moveData->targetSquare];
-			break;
-		}
-		case MoveType::BISHOP_PROMO:
-		{
-			if (moveData->side == SIDE_WHITE) currentPosition.whiteBishopsBB ^= BB::boardSquares[moveData->targetSquare];
-			else							  currentPosition.blackBishopsBB ^= BB::boardSquares[moveData->targetSquare];
-			break;
-		}
-		case MoveType::ROOK_PROMO:
-		{
-			if (moveData->side == SIDE_WHITE) currentPosition.whiteRooksBB ^= BB::boardSquares[moveData->targetSquare];
-			else							  currentPosition.blackRooksBB ^= BB::boardSquares[moveData->targetSquare];
-			break;
-		}
-		case MoveType::KNIGHT_PROMO:
-		{
-			if (moveData->side == SIDE_WHITE) currentPosition.whiteKnightsBB ^= BB::boardSquares[moveData->targetSquare];
-			else							  currentPosition.blackKnightsBB ^= BB::boardSquares[moveData->targetSquare];
-			break;
-		}
-		default:
-			break;
-	}
+	if (currentPosition.enPassantSquare != NO_SQUARE)
+		mCurrentZobristKey ^= ZobristKey::enpassantHashKeys[currentPosition.enPassantSquare];
+
+	currentPosition.enPassantSquare = NO_SQUARE;
+	currentPosition.fiftyMoveCounter++;
+	currentPosition.sideToMove = !currentPosition.sideToMove;
+
+	mCurrentZobristKey ^= ZobristKey::sideToPlayHashKey;
+
+	insertMoveIntoHistory(++mPly);
 }
 
-// this function deletes a pawn and adds in the piece that the pawn promoted to at the pawn's position
-void Board::promotePiece(MoveData* md, MoveType promoteTo)
+// takes back a null move, restoring the state of the position saved when it was made
+void Board::unmakeNullMove()
 {
-	// this will set the move's movetype to whatever piece it is promoting to
-	// this is useful for when we want to unpromote a piece during a move search
-	md->moveType = promoteTo;
+	mCurrentZobristKey = mZobristKeyHistory[mPly - 1];
 
-	if (md->side == SIDE_WHITE)
-	{
-		// reset the bit that the pawn is on (thus removing it from the bitboard)
-		currentPosition.whitePawnsBB ^= BB::boardSquares[md->targetSquare];
+	const BoardState& previousState = mStateHistory[mPly - 1];
+	currentPosition.enPassantSquare  = previousState.enPassantSquare;
+	currentPosition.fiftyMoveCounter = previousState.fiftyMoveCounter;
+	currentPosition.sideToMove 		 = !currentPosition.sideToMove;
 
-		// add the piece that the pawn promoted to to the respective bitboard 
-		if		(promoteTo == MoveType::QUEEN_PROMO)	currentPosition.whiteQueensBB  |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::ROOK_PROMO)	currentPosition.whiteRooksBB   |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::BISHOP_PROMO) currentPosition.whiteBishopsBB |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::KNIGHT_PROMO) currentPosition.whiteKnightsBB |= BB::boardSquares[md->targetSquare];
-	}
-	else
-	{
-		// reset the bit that the pawn is on (thus removing it from the bitboard)
-		currentPosition.blackPawnsBB ^= BB::boardSquares[md->targetSquare];
-
-		// add the piece that the pawn promoted to to the respective bitboard 
-		if		(promoteTo == MoveType::QUEEN_PROMO)	currentPosition.blackQueensBB  |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::ROOK_PROMO)	currentPosition.blackRooksBB   |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::BISHOP_PROMO) currentPosition.blackBishopsBB |= BB::boardSquares[md->targetSquare];
-		else if (promoteTo == MoveType::KNIGHT_PROMO) currentPosition.blackKnightsBB |= BB::boardSquares[md->targetSquare];
-	}
-}
\ No newline at end of file
+	deleteMoveFromHistory(mPly--);
+}
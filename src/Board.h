@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Bitboard.h"
@@ -9,6 +10,48 @@
 #include "MoveGeneration.h"
 #include "ZobristKey.h"
 
+// the attacks of a position, which are each computed the first time that they are needed at a ply (if they are needed at all)
+// and then shared by everything else that needs them at that ply, rather than being recomputed from scratch each time
+struct AttackCache
+{
+	// which parts of the cache have been filled for the position at the ply (the flags are below)
+	Byte filledFlags;
+
+	// the checkers, pins and king danger squares of each side, as if it were that side's turn to move
+	MoveGeneration::LegalityMasks legalityMasks[2];
+
+	// the squares attacked by each type of piece of each side (first index is the side, second index is the piece type)
+	Bitboard pieceAttacksBB[2][6];
+
+	// the squares attacked by any piece of each side
+	Bitboard attackedBB[2];
+
+	enum Flags : Byte
+	{
+		WHITE_LEGALITY_MASKS = 1 << 0,
+		BLACK_LEGALITY_MASKS = 1 << 1,
+		WHITE_ATTACKS        = 1 << 2,
+		BLACK_ATTACKS        = 1 << 3,
+	};
+};
+
+// when copy-make is on (it is chosen when the engine is built, with the ATHENA_COPY_MAKE cmake option), the position before each move
+// is copied onto a stack, and unmaking the move copies it back rather than undoing the changes that the move made one by one. making a
+// move still updates the copy incrementally (the new position has to be right), but no longer saves the board state for the undo. the
+// zobrist key history (which repetitions are found with) and the incremental attacks (which are not part of the position) are kept
+// the same way in both
+#ifndef ATHENA_COPY_MAKE
+	#define ATHENA_COPY_MAKE 0
+#endif
+
+#if ATHENA_COPY_MAKE
+// an entry of the copy-make position stack, aligned so that each position starts on its own cache line
+struct alignas(64) PositionStackEntry
+{
+	ChessPosition position;
+};
+#endif
+
 // this class handles all of the piece movement, position updating, as well as some additional utility functions for Athena or the UCI handler
 class Board
 {    
@@ -19,23 +62,53 @@ private:
 	// each index contains the zobrist key of the board's position at that ply in the game's history
 	ZobristKey::zkey mZobristKeyHistory[1000];
 
-	// stores the current ply (i.e., how many half-moves have occured so far)
+	// each index contains the state of the position (that moves cannot restore on their own) just before the move at that ply was made.
+	// with copy-make, only null moves save their state here, as the copy of the position holds it for every other move
+	BoardState mStateHistory[1000];
+
+	// each index contains the attacks of the board's position at that ply. as a position is entered, its cache is emptied,
+	// and it stays valid until a different position is reached at the same ply (moves being unmade restore the position)
+	AttackCache mAttackCache[1000];
+
+#if ATHENA_COPY_MAKE
+	// each index contains the position just before the move at that ply was made
+	PositionStackEntry mPositionStack[1000];
+#endif
+
+	// stores the current ply (i.e., how many half-moves have occured since the position was set with a FEN string)
 	short mPly;
 
-	void initializeAuxillaryBitboards();
+	// the number of plies that had been played before the position set with a FEN string (whose moves are not known, so they are not in
+	// the history). this is only needed to write the full move number back out in getFEN
+	int mPlyOffset = 0;
+
+	void fillAttacks(Colour side);
+
+	// when incremental attacks are on, these are kept up to date by makeMove and unmakeMove rather than being computed when needed
+	// mAttacksFrom holds the squares attacked by the piece on each square, and mAttacksTo holds the squares of the pieces attacking each square
+	bool mIncrementalAttacks = false;
+	Bitboard mAttacksFrom[64];
+	Bitboard mAttacksTo[64];
 
-	void setCastleMoveData(MoveData* castleMoveData, MoveData* kingMD, MoveData* rookMD);
-	bool makeCastleMove(MoveData* moveData);
-	void setEnPassantSquares(MoveData* moveData);
-	void updateBitboardWithMove(MoveData* moveData);
-	void undoPromotion(MoveData* moveData);
+	Bitboard computeAttacksFrom(Byte square);
+	Bitboard getSquaresChangedByMove(Move move);
+	void resetIncrementalAttacks();
+	void updateIncrementalAttacks(Bitboard changedSquaresBB);
+
+	void updateBitboardWithCastle(Move move);
+	void setEnPassantSquares(Move move);
+	void updateBitboardWithMove(Move move);
+	void updatePiecesWithMove(Move move);
+	void undoPiecesWithMove(Move move);
+	void updateZobristKeyWithMove(Move move);
+	void updateScoresWithMove(Move move, int sign);
+	void updatePawnKeyWithMove(Move move);
 
 	void insertMoveIntoHistory(short ply);
 	void deleteMoveFromHistory(short ply);
 
-	void setFENPiecePlacement(char pieceType, Byte square);
 	std::string getSquareStringCoordinate(Byte square);
-	Byte getSquareNumberCoordinate(const std::string& stringCoordinate);
+	Byte getSquareNumberCoordinate(std::string_view stringCoordinate);
 
 public:
 	Board() {}
@@ -43,21 +116,37 @@ public:
 	// contains all the information about the current position of the board
 	ChessPosition currentPosition;
 
-	void init();
-
-	std::string getMoveLANString(MoveData* moveData);
+	std::string getMoveLANString(Move move);
 	bool makeMoveLAN(const std::string& lanString);
-	void setPositionFEN(const std::string& fenString);
+	bool setPositionFEN(std::string_view fenString, std::string_view* epdOperations = nullptr);
+	std::string getFEN(bool includeMoveCounters = true);
 
-	bool makeMove(MoveData* moveData);
-	bool unmakeMove(MoveData* moveData, bool positionUpdated = true);
-	void promotePiece(MoveData* md, MoveType promoteTo);
+	void makeMove(Move move);
+	void unmakeMove(Move move);
+	void makeNullMove();
+	void unmakeNullMove();
 	
 	Byte computeKingSquare(Bitboard kingBB);
+
+	template <Colour attackingSide> bool squareAttacked(Byte square);
 	bool squareAttacked(Byte square, Colour attackingSide);
 
-	void getLeastValuableAttacker(Byte square, Colour attackingSide, int* pieceValue, Bitboard** pieceBB, Bitboard* attackingPiecesBB);
+	void setIncrementalAttacks(bool enabled);
+	bool usesIncrementalAttacks()		{ return mIncrementalAttacks; }
+	Bitboard getAttacksFrom(Byte square) { return mIncrementalAttacks ? mAttacksFrom[square] : computeAttacksFrom(square); }
+	bool verifyIncrementalAttacks();
+
+	const MoveGeneration::LegalityMasks& getLegalityMasks(Colour side);
+	Bitboard getAttackedSquares(Colour side);
+	Bitboard getPieceAttacks(Colour side, PieceType piece);
+	bool isInCheck(Colour side) { return getLegalityMasks(side).checkersBB; }
+
+	template <Colour attackingSide>
+	Bitboard getLeastValuableAttackers(Byte square, Bitboard excludedBB, int* pieceValue);
 
+	ZobristKey::zkey getZobristKey()				{ return mCurrentZobristKey;							 }
+	bool verifyZobristKey();
+	bool verifyScores();
 	ZobristKey::zkey* getZobristKeyHistory()		{ return mZobristKeyHistory;							 }
 	short getCurrentPly()							{ return mPly;											 }
 	short getFiftyMoveCounter()					    { return currentPosition.fiftyMoveCounter;				 }
@@ -1,14 +1,19 @@
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
 
 #include "ChessGame.h"
 #include "Constants.h"
 #include "Outcomes.h"
 
-// initializes the board and opening book state
+// initializes the opening book state, and sets the board to the starting position (so that commands sent before any "position"
+// command, such as perft, work on a real position rather than an empty board)
 void ChessGame::init()
 {
-	mBoard.init();
     mCheckOpeningBook = true;
+    setPositionFEN(FEN_STARTING_STRING);
 }
 
 // this function uses Athena to return the best move it can find (in LAN format)
@@ -31,14 +36,18 @@ std::string ChessGame::findBestMove(Colour side, float timeToMove)
 
     // if no opening move could be used, then use Athena to find the best move via minimax searching
     mAthena.setColour(side);
-    MoveData moveToMake = mAthena.search(&mBoard, timeToMove);
+    Move moveToMake = mAthena.search(&mBoard, timeToMove);
 
-    return mBoard.getMoveLANString(&moveToMake);
+    return mBoard.getMoveLANString(moveToMake);
 }
 
 // uses an FEN string to set the board's position using the engine's abstractions
-void ChessGame::setPositionFEN(const std::string& fenString)
+// returns false (leaving the game as it was) if the FEN string is not valid
+bool ChessGame::setPositionFEN(std::string_view fenString)
 {
+	if (!mBoard.setPositionFEN(fenString))
+		return false;
+
     // if the FEN position we set it to isn't the starting position, then Athena won't use her opening book to find moves
     if (fenString == FEN_STARTING_STRING)
         mCheckOpeningBook = true;
@@ -48,7 +57,7 @@ void ChessGame::setPositionFEN(const std::string& fenString)
     // erase any move history we had before resetting the board's position
 	mLANStringHistory.clear();
 
-	mBoard.setPositionFEN(fenString);
+	return true;
 }
 
 // make a move on the board using a move in the LAN format, adding the move to the game's history if it was legal
@@ -57,3 +66,268 @@ void ChessGame::makeMoveLAN(const std::string& lanString)
 	if (mBoard.makeMoveLAN(lanString))
 		mLANStringHistory.push_back(lanString);
 }
+
+// the positions searched by the bench and stress test debugging functions
+const std::string benchPositions[] =
+{
+	FEN_STARTING_STRING,
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"r1bq1rk1/pp2ppbp/2np1np1/8/3NP3/2N1BP2/PPPQ2PP/R3KB1R w KQ - 3 9",
+	"8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+};
+
+const int NUM_BENCH_POSITIONS = sizeof(benchPositions) / sizeof(benchPositions[0]);
+
+// searches each of a fixed set of positions to a fixed depth, and reports how many nodes were searched per second
+// as the search is fully determined by the positions and the depth, the node counts can be compared between builds as well
+// note that this is a debugging function. the positions are searched on a board and with a search of their own (the board gets attacks in
+// the way given), so the game's board and search are left as they were
+void ChessGame::bench(int depth, bool incrementalAttacks)
+{
+	std::unique_ptr<Board> board = std::make_unique<Board>();
+	board->setIncrementalAttacks(incrementalAttacks);
+
+	std::unique_ptr<Athena> athena = std::make_unique<Athena>();
+	athena->setDepth(depth);
+	athena->setPrintSearchStats(false);
+
+	long long totalNodes = 0;
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (const std::string& fenString : benchPositions)
+	{
+		// every position is searched from a clean slate, so that the node counts do not depend on the previous searches
+		athena->resetSearchData();
+		board->setPositionFEN(fenString);
+
+		athena->setColour(board->currentPosition.sideToMove);
+		athena->search(board.get(), std::numeric_limits<float>::max());
+
+		totalNodes += athena->getNodes();
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << "bench depth " << depth << ": " << totalNodes << " nodes in " << seconds << " seconds (" << (long long)(totalNodes / seconds) << " nodes per second)\n";
+}
+
+// runs bench and perft once with attacks computed when they are needed, and once with incremental attacks, so that their speeds can be compared
+// both benches search every position from a clean slate, so they search the same number of nodes (as does each perft). the perft is run on
+// a board of its own, so the game's board is left as it was
+void ChessGame::benchAttacks(int depth)
+{
+	std::unique_ptr<Board> board = std::make_unique<Board>();
+
+	for (bool incrementalAttacks : { false, true })
+	{
+		std::cout << (incrementalAttacks ? "incremental attacks:\n" : "attacks computed when needed:\n");
+
+		bench(depth, incrementalAttacks);
+
+		board->setIncrementalAttacks(incrementalAttacks);
+		board->setPositionFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+		Perft::run(board.get(), 4);
+	}
+}
+
+// the size of the transposition table of each search in the stress test (in megabytes). it is kept small, as there is one for each thread
+const int STRESS_TEST_HASH_SIZE = 4;
+
+// the result of searching one of the bench positions
+struct StressTestResult
+{
+	Move bestMove;
+	int nodes;
+};
+
+// searches every bench position with the board and search given (to the depth that the search has been set to), starting from the position
+// at the index given (so that threads starting at different indices are searching different positions at the same time), and stores the results
+// by the index of the position
+void searchBenchPositions(Board* board, Athena* athena, int firstPosition, std::vector<StressTestResult>& results)
+{
+	for (int i = 0; i < NUM_BENCH_POSITIONS; i++)
+	{
+		int position = (firstPosition + i) % NUM_BENCH_POSITIONS;
+
+		athena->resetSearchData();
+		board->setPositionFEN(benchPositions[position]);
+		athena->setColour(board->currentPosition.sideToMove);
+
+		Move bestMove = athena->search(board, std::numeric_limits<float>::max());
+		results[position] = { bestMove, athena->getNodes() };
+	}
+}
+
+// runs a search of each bench position on its own, and then the same searches on many threads at once (each thread with its own board and
+// search), checking that every search on the threads finds the same move with the same number of nodes. if any state were shared between
+// the searches, then they would interfere with each other, and the results would not match
+// note that this is a debugging function. each search has its own board, so the game's board is left as it was
+void ChessGame::stressTest(int numThreads, int depth)
+{
+	// every search is given its own board and instance of Athena, which are all created before any of the threads start
+	std::vector<std::unique_ptr<Board>> boards;
+	std::vector<std::unique_ptr<Athena>> athenas;
+	for (int i = 0; i <= numThreads; i++)
+	{
+		boards.push_back(std::make_unique<Board>());
+		athenas.push_back(std::make_unique<Athena>(STRESS_TEST_HASH_SIZE));
+
+		athenas.back()->setDepth(depth);
+		athenas.back()->setPrintSearchStats(false);
+	}
+
+	// the last board and search find the results that the threads are checked against, by searching the positions one at a time
+	std::vector<StressTestResult> expectedResults(NUM_BENCH_POSITIONS);
+	searchBenchPositions(boards[numThreads].get(), athenas[numThreads].get(), 0, expectedResults);
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<std::vector<StressTestResult>> threadResults(numThreads, std::vector<StressTestResult>(NUM_BENCH_POSITIONS));
+	std::vector<std::thread> threads;
+	for (int i = 0; i < numThreads; i++)
+		threads.emplace_back(searchBenchPositions, boards[i].get(), athenas[i].get(), i, std::ref(threadResults[i]));
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	int mismatches = 0;
+	for (int i = 0; i < numThreads; i++)
+		for (int position = 0; position < NUM_BENCH_POSITIONS; position++)
+		{
+			const StressTestResult& result   = threadResults[i][position];
+			const StressTestResult& expected = expectedResults[position];
+
+			if (result.bestMove != expected.bestMove || result.nodes != expected.nodes)
+			{
+				mismatches++;
+				std::cout << "thread " << i << " mismatch on " << benchPositions[position] << ": " 
+						  << boards[i]->getMoveLANString(result.bestMove) << " with " << result.nodes << " nodes (expected " 
+						  << boards[i]->getMoveLANString(expected.bestMove) << " with " << expected.nodes << " nodes)\n";
+			}
+		}
+
+	std::cout << "stress test: " << numThreads << " threads searched " << numThreads * NUM_BENCH_POSITIONS << " positions to depth " << depth 
+			  << " in " << seconds << " seconds, " << mismatches << " mismatches\n";
+}
+
+
+// FEN strings that are malformed, or that describe positions that are not possible, which the FEN benchmark checks are all rejected
+const char* invalidFENStrings[] =
+{
+	"",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/8 w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/7/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnr/ppppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQ1BNR w kq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBKKBNR w kq - 0 1",
+	"P3k3/8/8/8/8/8/8/4K3 w - - 0 1",
+	"4k3/8/8/8/8/PPPPPPPP/PPPPPPPP/4K3 w - - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKQNR w - - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkqK - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkx - 0 1",
+	"rnbqkbn1/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e6 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq i6 0 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1x",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 256 1",
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 99999999999",
+	"4k3/4R3/8/8/8/8/8/4K3 w - - 0 1",
+};
+
+// measures how many FEN strings can be parsed and written per second, using the bench positions. it also checks that writing out the
+// bench positions, and every position one move after them, and parsing the result back gives the same position, and that malformed
+// FEN strings are rejected
+// note that this is a debugging function. it uses a board of its own, so the game's board is left as it was
+void ChessGame::benchFEN(int iterations)
+{
+	std::unique_ptr<Board> board = std::make_unique<Board>();
+	board->setIncrementalAttacks(mBoard.usesIncrementalAttacks());
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++)
+		for (const std::string& fenString : benchPositions)
+			board->setPositionFEN(fenString);
+
+	double parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// the length of every string written is added up, so that the strings are used for something
+	long long totalLength = 0;
+	startTime = std::chrono::steady_clock::now();
+
+	for (const std::string& fenString : benchPositions)
+	{
+		board->setPositionFEN(fenString);
+		for (int i = 0; i < iterations; i++)
+			totalLength += board->getFEN().size();
+	}
+
+	double writeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// every position written out and parsed back in must have the same zobrist key, and must be written out the same way again
+	int mismatches = 0;
+	auto checkRoundTrip = [&](Board* positionBoard)
+	{
+		std::string fenString = positionBoard->getFEN();
+		if (!board->setPositionFEN(fenString) || board->getZobristKey() != positionBoard->getZobristKey() || board->getFEN() != fenString)
+		{
+			mismatches++;
+			std::cout << "round trip mismatch on " << fenString << " (read back as " << board->getFEN() << ")\n";
+		}
+	};
+
+	std::unique_ptr<Board> positionBoard = std::make_unique<Board>();
+	for (const std::string& fenString : benchPositions)
+	{
+		positionBoard->setPositionFEN(fenString);
+		if (positionBoard->getFEN() != fenString)
+		{
+			mismatches++;
+			std::cout << "round trip mismatch on " << fenString << " (written as " << positionBoard->getFEN() << ")\n";
+		}
+
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(positionBoard.get(), positionBoard->currentPosition.sideToMove, moveList);
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			positionBoard->makeMove(moveList[i].move);
+			checkRoundTrip(positionBoard.get());
+			positionBoard->unmakeMove(moveList[i].move);
+		}
+	}
+
+	// the move counters can be left out, with anything after the first four fields kept as the EPD operations
+	std::string_view epdOperations;
+	if (!board->setPositionFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - bm e4; id \"start\";\r\n", &epdOperations) ||
+		board->getFEN() != FEN_STARTING_STRING || epdOperations != "bm e4; id \"start\";")
+	{
+		mismatches++;
+		std::cout << "EPD string was not parsed correctly\n";
+	}
+
+	int invalidAccepted = 0;
+	for (const char* fenString : invalidFENStrings)
+		if (board->setPositionFEN(fenString))
+		{
+			invalidAccepted++;
+			std::cout << "invalid FEN string was accepted: " << fenString << "\n";
+		}
+
+	long long numPositions = (long long)iterations * NUM_BENCH_POSITIONS;
+	std::cout << "fen bench: parsed " << numPositions << " positions in " << parseSeconds << " seconds (" << (long long)(numPositions / parseSeconds) 
+			  << " positions per second), wrote " << numPositions << " positions in " << writeSeconds << " seconds (" << (long long)(numPositions / writeSeconds) 
+			  << " positions per second, " << totalLength << " characters)\n";
+	std::cout << mismatches << " round trip mismatches, " << invalidAccepted << " invalid FEN strings accepted\n";
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Athena.h"
@@ -8,6 +9,7 @@
 #include "Board.h"
 #include "Eval.h"
 #include "MoveData.h"
+#include "Perft.h"
 
 // this class handles engine related commands from various UCI commands, such as "go" and "position"
 class ChessGame
@@ -26,10 +28,26 @@ public:
 	void init();
 
 	void setHashSize(int newSize) { mAthena.setTranspositionTableSize(newSize); }
-	void setPositionFEN(const std::string& fenString);
+	void setPawnHashSize(int newSize) { mAthena.setPawnHashTableSize(newSize); }
+	bool setPositionFEN(std::string_view fenString);
 	std::string findBestMove(Colour side, float timeToMove);
 	void makeMoveLAN(const std::string& lanString);
+	void bench(int depth) { bench(depth, mBoard.usesIncrementalAttacks()); }
+	void bench(int depth, bool incrementalAttacks);
+	void benchAttacks(int depth);
+	void stressTest(int numThreads, int depth);
+	void benchFEN(int iterations);
+
+	void setIncrementalAttacks(bool enabled) { mBoard.setIncrementalAttacks(enabled); }
+
+	void perft(int depth)  { Perft::run(&mBoard, depth);    }
+	void divide(int depth) { Perft::divide(&mBoard, depth); }
+	void perftSuite()	   { Perft::runSuite(&mBoard);		}
+	void verifyZobristKeys(int depth) { Perft::verifyZobristKeys(&mBoard, depth); }
+	void verifyScores(int depth) 	  { Perft::verifyScores(&mBoard, depth); 	  }
+	void benchMakeMove(int depth)     { Perft::benchMakeMove(&mBoard, depth);     }
+	void parallelPerft(int depth, int maxThreads, int hashSizeMB) { Perft::runParallel(&mBoard, depth, maxThreads, hashSizeMB); }
 
 	Colour getSideToMove() { return mBoard.currentPosition.sideToMove; 														   }
-    int getBoardEval() 	   { return Eval::evaluatePosition(&mBoard, Eval::getMidgameValue(mBoard.currentPosition.occupiedBB)); }
+    int getBoardEval() 	   { return Eval::evaluatePosition(&mBoard, Eval::computeMaterialHashTableEntry(mBoard.currentPosition.materialKey)); }
 };
@@ -39,6 +39,57 @@ struct ChessPosition
 
 	Colour sideToMove = SIDE_WHITE;
 
+	// the material and square piece table values of all the pieces, summed from white's point of view, once using the values for
+	// the midgame and once using the values for the endgame. these are kept up to date by the board as moves are made, so that the
+	// evaluation only has to blend the two by how far into the game it is, rather than adding up every piece on the board again
+	int midgameScore = 0;
+	int endgameScore = 0;
+
+	// the number of each side's pawns, knights, bishops, rooks and queens, packed into 6 bits each (see Eval::getMaterialKeyIncrement).
+	// the material hash table is indexed by this, and like the scores above, the board keeps it up to date as moves are made
+	uint64_t materialKey = 0;
+
+	// the zobrist key of only the pawns of both sides, which the pawn hash table is indexed by. like the scores above, the board keeps
+	// this up to date as moves are made (see ZobristKey::generatePawnKey)
+	uint64_t pawnKey = 0;
+
+	// the type of the piece on each square (or NO_PIECE if the square is empty). the colour of the piece can be found
+	// with the colour bitboards. this is kept in sync with the piece bitboards, so that finding what is on a square is a single read
+	PieceType pieces[64];
+
+	ChessPosition()
+	{
+		for (int square = 0; square < 64; square++)
+			pieces[square] = NO_PIECE;
+	}
+
+	// maps each colour and type of piece to the member above that holds its bitboard (indexed by side and then by PieceType)
+	static constexpr Bitboard ChessPosition::* pieceBitboards[2][6] =
+	{
+		{ &ChessPosition::whitePawnsBB, &ChessPosition::whiteKnightsBB, &ChessPosition::whiteBishopsBB, 
+		  &ChessPosition::whiteRooksBB, &ChessPosition::whiteQueensBB,  &ChessPosition::whiteKingBB },
+		{ &ChessPosition::blackPawnsBB, &ChessPosition::blackKnightsBB, &ChessPosition::blackBishopsBB, 
+		  &ChessPosition::blackRooksBB, &ChessPosition::blackQueensBB,  &ChessPosition::blackKingBB },
+	};
+
+	// returns the bitboard containing all of the pieces of the given colour and type
+	Bitboard& getPieceBB(Colour side, PieceType piece) { return this->*pieceBitboards[side][piece]; 		 }
+
+	// returns the bitboard containing all of the pieces of the given colour
+	Bitboard& getColourBB(Colour side) 				   { return side == SIDE_WHITE ? whitePiecesBB : blackPiecesBB; }
+
+	// returns the type of the piece of the given colour on the given square (or NO_PIECE if there is no piece of that colour there)
+	PieceType getPieceOnSquare(Byte square, Colour side) { return (getColourBB(side) & BB::boardSquares[square]) ? pieces[square] : NO_PIECE; }
+
 	// this function resets all of the data in the instance to the default values above
 	void reset() { *this = ChessPosition(); }
+};
+
+// stores the parts of a position that a move cannot restore on its own when it is unmade
+// the board keeps one of these for each ply, saved just before the move at that ply is made
+struct BoardState
+{
+	Byte castlePrivileges;
+	Byte enPassantSquare;
+	Byte fiftyMoveCounter;
 };
\ No newline at end of file
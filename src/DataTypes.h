@@ -4,4 +4,16 @@
 
 typedef uint8_t  Byte;
 typedef uint16_t DoubleByte;
-typedef bool Colour;
\ No newline at end of file
+typedef bool Colour;
+
+// the types of pieces, independent of their colour. the values are used for indexing, so their order matters
+enum PieceType : Byte
+{
+	PAWN,
+	KNIGHT,
+	BISHOP,
+	ROOK,
+	QUEEN,
+	KING,
+	NO_PIECE,
+};
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <array>
 #include <iostream>
 
 #include "Bitboard.h"
@@ -37,17 +39,52 @@ namespace Eval
     const int OUTPOST_BONUS = 12;
     const int KNIGHT_PAWN_COUNT_ADJUSTMENT[] = { -20, -16, -12, -8, -4,  0,  4,  8, 12 };
 
-    // pawn hash table 
-    struct PawnHashTableEntry
+    // contains the distances between any 2 squares (with no diagonal movement), generated at compile time
+    constexpr std::array<std::array<int, 64>, 64> distFromTable = []
     {
-        int structureEval;
-        Bitboard pawnsBB = 0;
-    };
-    PawnHashTableEntry* pawnHashTable;
-    const int PAWN_HASH_TABLE_SIZE = 1000000;
+        std::array<std::array<int, 64>, 64> distances {};
+
+        for (int from = 0; from < 64; from++)
+            for (int to = 0; to < 64; to++)
+            {
+                // find how many rows apart the two squares are
+                int rowDist = (from % 8) > (to % 8) ? (from % 8) - (to % 8) : (to % 8) - (from % 8);
+
+                // find how many columns apart the two squares are
+                int columnDist = (from / 8) > (to / 8) ? (from / 8) - (to / 8) : (to / 8) - (from / 8);
+
+                distances[from][to] = rowDist + columnDist;
+            }
+
+        return distances;
+    }();
+
+    static_assert(distFromTable[0][63] == 14 && distFromTable[27][27] == 0 && distFromTable[9][3] == distFromTable[3][9], "distFromTable is wrong");
+
+    // builds the table of the material and square piece table value of each piece on each square (for either the midgame or the endgame)
+    // only the king has a different square piece table in the endgame. the tables are laid out from black's side of the board, which is why
+    // white's pieces read them from the opposite end
+    constexpr std::array<std::array<std::array<int, 64>, 6>, 2> computePieceSquareValues(bool endgame)
+    {
+        const int* pieceTables[6] = { pst::pawnTable, pst::knightTable, pst::bishopTable, pst::rookTable, pst::queenTable, 
+                                      endgame ? pst::endgameKingTable : pst::midgameKingTable };
 
-    // contains the distances between any 2 squares (with no diagonal movement)
-    int distFromTable[64][64];
+        std::array<std::array<std::array<int, 64>, 6>, 2> values {};
+        for (int piece = PAWN; piece <= KING; piece++)
+            for (int square = 0; square < 64; square++)
+            {
+                values[SIDE_WHITE][piece][square] =   PIECE_VALUES[piece] + pieceTables[piece][63 - square];
+                values[SIDE_BLACK][piece][square] = -(PIECE_VALUES[piece] + pieceTables[piece][square]);
+            }
+
+        return values;
+    }
+
+    extern constexpr std::array<std::array<std::array<int, 64>, 6>, 2> midgamePieceSquareValues = computePieceSquareValues(false);
+    extern constexpr std::array<std::array<std::array<int, 64>, 6>, 2> endgamePieceSquareValues = computePieceSquareValues(true);
+
+    static_assert(midgamePieceSquareValues[SIDE_WHITE][KING][ChessCoord::G1] == KING_VALUE + 30 && 
+                  endgamePieceSquareValues[SIDE_BLACK][KING][ChessCoord::E5] == -(KING_VALUE + 40), "the piece square values are wrong");
 
     // returns the evaluation of the board's position relative to the specified side
     int evaluateBoardRelativeTo(Colour side, int eval)
@@ -56,143 +93,188 @@ namespace Eval
     }
 
     // represents as a decimal how far into the midgame we are. A value of 1.0 indicates the start, and a value of 0.0 would represent endgame
-    float getMidgameValue(Bitboard occupiedBB)
+    float getMidgameValue(int numPieces)
     {
-        // 32 = number of total pieces possible
-        return countSetBits64(occupiedBB)/32.f;
+        return numPieces / (float)MAX_PIECES;
     }
 
-    // dynamically allocates memory for the pawn hash table, equal in size to sizeof(PawnHashTableEntry) * PAWN_HASH_TABLE_SIZE
-    void initPawnHashTable()
+    // the number of entries in the material hash table (a power of two, as the index is the top bits of the key's hash)
+    const int MATERIAL_HASH_TABLE_BITS = 13;
+
+    MaterialHashTable::MaterialHashTable() : entries(1 << MATERIAL_HASH_TABLE_BITS) {}
+
+    // returns the entry for the material key given, working it out first if it is not already in the table. the key packs the piece counts
+    // into its lowest bits, so it is multiplied by a large odd constant to spread it over the table, rather than being masked
+    const MaterialHashTableEntry& MaterialHashTable::probe(uint64_t materialKey)
     {
-        pawnHashTable = new PawnHashTableEntry[PAWN_HASH_TABLE_SIZE];
+        MaterialHashTableEntry& entry = entries[(materialKey * 0x9e3779b97f4a7c15ULL) >> (64 - MATERIAL_HASH_TABLE_BITS)];
+        if (entry.materialKey != materialKey)
+            entry = computeMaterialHashTableEntry(materialKey);
+
+        return entry;
     }
 
-    // initializes the values describing the distance between any 2 squares in the distFromTable
-    void initDistFromTable()
+    // returns a newly computed material key of the position (the board only does this when its position is set from a FEN string)
+    uint64_t computeMaterialKey(ChessPosition& position)
     {
-        for (int from = 0; from < 64; from++)
-            for (int to = 0; to < 64; to++)
-            {
-                // find how many rows apart the two squares are
-                int rowDist = abs((from % 8) - (to % 8));
+        uint64_t materialKey = 0;
+        for (Colour side : { SIDE_WHITE, SIDE_BLACK })
+            for (int piece = PAWN; piece < KING; piece++)
+                materialKey += countSetBits64(position.getPieceBB(side, (PieceType)piece)) * getMaterialKeyIncrement(side, (PieceType)piece);
 
-                // find how many columns apart the two squares are
-                int columnDist = abs((from / 8) - (to / 8));
+        return materialKey;
+    }
 
-                distFromTable[from][to] = rowDist + columnDist;
-            }
+    // works out everything stored in the material hash table from the numbers of pieces in the material key
+    MaterialHashTableEntry computeMaterialHashTableEntry(uint64_t materialKey)
+    {
+        MaterialHashTableEntry entry;
+        entry.materialKey = materialKey;
+
+        // both kings are always on the board
+        int numPieces = 2;
+        int numMinorPieces = 0;
+        bool hasMajorPiecesOrPawns = false;
+
+        for (Colour side : { SIDE_WHITE, SIDE_BLACK })
+        {
+            int pawns   = getPieceCount(materialKey, side, PAWN);
+            int knights = getPieceCount(materialKey, side, KNIGHT);
+            int bishops = getPieceCount(materialKey, side, BISHOP);
+            int rooks   = getPieceCount(materialKey, side, ROOK);
+            int queens  = getPieceCount(materialKey, side, QUEEN);
+
+            numPieces += pawns + knights + bishops + rooks + queens;
+            numMinorPieces += knights + bishops;
+            hasMajorPiecesOrPawns |= pawns || rooks || queens;
+
+            // bishop pair bonus. knights also lose value as the number of their side's pawns decreases (the adjustment table only goes up to
+            // 8 pawns, so a position set up with more than that is given the adjustment for 8)
+            int sideImbalance = (bishops == 2 ? BISHOP_PAIR_BONUS : 0) + knights * KNIGHT_PAWN_COUNT_ADJUSTMENT[std::min(pawns, 8)];
+            entry.imbalance += side == SIDE_WHITE ? sideImbalance : -sideImbalance;
+
+            if (!knights && !bishops && !rooks && !queens)
+                entry.flags |= side == SIDE_WHITE ? MaterialHashTableEntry::WHITE_PAWNS_ONLY : MaterialHashTableEntry::BLACK_PAWNS_ONLY;
+        }
+
+        if (!hasMajorPiecesOrPawns && numMinorPieces <= 1)
+            entry.flags |= MaterialHashTableEntry::INSUFFICIENT_MATERIAL;
+
+        entry.midgameValue = getMidgameValue(numPieces);
+        return entry;
     }
 
-    // initializes the tables that are necessary for board evaluation
-    void init()
+    // allocates memory for the pawn hash table, using the default size
+    PawnHashTable::PawnHashTable()
     {
-        initPawnHashTable();
-        initDistFromTable();
+        resize(DEFAULT_PAWN_HASH_SIZE);
     }
 
-    // calculates the value of a pawn based on its structure
-    int evaluatePawnStructure(Bitboard friendlyPawnsBB, Bitboard enemyPawnsBB, ChessPosition& position)
+    // changes the size of the pawn hash table (which also empties it), using the largest power of two number of entries that fits in the size given
+    void PawnHashTable::resize(int sizeMB)
     {
-        // if there are no pawns left, return an evaluation of 0
-        if (!friendlyPawnsBB)
-            return 0;
-        
-        // if there is an entry with the same hash, we can use that entry's value for the pawn's evaluation
-        int hashEntryIndex = friendlyPawnsBB % PAWN_HASH_TABLE_SIZE;
-        if (pawnHashTable[hashEntryIndex].pawnsBB == friendlyPawnsBB)
-            return pawnHashTable[hashEntryIndex].structureEval;
+        uint64_t numEntries = 1;
+        while (numEntries * 2 * sizeof(PawnHashTableEntry) <= (uint64_t)sizeMB * 1024 * 1024)
+            numEntries *= 2;
 
-        int structureValue = 0;
-        for (int square = 0; square < 64; square++)
-        {
-            if (BB::boardSquares[square] & friendlyPawnsBB)
-            {
-                // double/triple pawn penalty. apply when pawns are on the same file (applied per pawn. so a doubled pawn is a penalty of -10 * 2 = -20)
-                if ((BB::fileMask[square % 8] & ~BB::boardSquares[square]) & friendlyPawnsBB)
-                    structureValue -= PAWN_DOUBLED_PENALTY;
-
-                else if ((friendlyPawnsBB == position.whitePawnsBB && (BB::northOne(BB::boardSquares[square]) & position.occupiedBB)) || 
-                    (friendlyPawnsBB == position.blackPawnsBB && (BB::southOne(BB::boardSquares[square]) & position.occupiedBB)))
-                    structureValue -= BLOCKED_PAWN_PENALTY;
-
-                // isolated pawns penalty
-                else if (!(BB::adjacentFiles[square % 8] & friendlyPawnsBB))
-                    structureValue -= PAWN_ISOLATED_PENALTY;
-                // if the pawn is not isolated, it may be backwards
-                else
-                {
-                    // if the adjacent pawns are a rank ahead of the considered pawn
-                    // AND the pawn cannot move up, 
-                }
-                
-                // passed pawns bonus
-                if (!((BB::adjacentFiles[square % 8] | BB::fileMask[square % 8]) & enemyPawnsBB))
-                    structureValue += PAWN_PASSED_BONUS;
-            }
-        }
-        
-        // set the values we just calculated into the pawn hash table for faster future pawn evaluation
-        pawnHashTable[hashEntryIndex].pawnsBB       = friendlyPawnsBB;
-        pawnHashTable[hashEntryIndex].structureEval = structureValue;
+        entries.assign(numEntries, PawnHashTableEntry());
+        mask = numEntries - 1;
+    }
 
-        return structureValue;
+    // empties the pawn hash table, so that nothing from previous searches is remembered
+    void PawnHashTable::clear()
+    {
+        std::fill(entries.begin(), entries.end(), PawnHashTableEntry());
     }
 
-    // evaluates how strong the pawn shield around the king is for the white side by checking for pawns being in select locations
-    int whiteKingShieldValue(int kingSquare, Bitboard friendlyPawnsBB)
+    // the wings of the board that a king can have a pawn shield on (a king in the middle of the board has no pawn shield)
+    enum ShieldWing
     {
-        int shieldValue = 0;
+        LONG_CASTLE_WING,
+        SHORT_CASTLE_WING,
+        NO_WING,
+    };
 
-        // if the king has long castled (or is otherwise on the west side of the board)
-        if (kingSquare <= ChessCoord::C1)
+    // the squares that a side's pawns shield its king from when it has castled onto each wing (indexed by side, then by ShieldWing)
+    constexpr Bitboard kingShieldMasks[2][2] =
+    {
         {
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::A2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::A3]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::B2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::B3]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::C2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-        }
-
-        // if the king has short castled (or is otherwise on the east side of the board)
-        else if (kingSquare >= ChessCoord::G1)
+            BB::boardSquares[ChessCoord::A2] | BB::boardSquares[ChessCoord::A3] | BB::boardSquares[ChessCoord::B2] | 
+            BB::boardSquares[ChessCoord::B3] | BB::boardSquares[ChessCoord::C2],
+            BB::boardSquares[ChessCoord::H2] | BB::boardSquares[ChessCoord::H3] | BB::boardSquares[ChessCoord::G2] | 
+            BB::boardSquares[ChessCoord::G3] | BB::boardSquares[ChessCoord::F2],
+        },
         {
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::H2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::H3]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::G2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::G3]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::F2]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-        }
+            BB::boardSquares[ChessCoord::A7] | BB::boardSquares[ChessCoord::A6] | BB::boardSquares[ChessCoord::B7] | 
+            BB::boardSquares[ChessCoord::B6] | BB::boardSquares[ChessCoord::C7],
+            BB::boardSquares[ChessCoord::H7] | BB::boardSquares[ChessCoord::H6] | BB::boardSquares[ChessCoord::G7] | 
+            BB::boardSquares[ChessCoord::G6] | BB::boardSquares[ChessCoord::F7],
+        },
+    };
+
+    // finds which wing the king is on, for the purposes of its pawn shield. the king has long castled (or is otherwise on the west side
+    // of the board) if it is at or before the long castle square, and has short castled (or is otherwise on the east side) if it is at or after
+    // the short castle square
+    ShieldWing getShieldWing(int kingSquare, Colour side)
+    {
+        if (kingSquare <= (side == SIDE_WHITE ? ChessCoord::C1 : ChessCoord::C8))
+            return LONG_CASTLE_WING;
+        if (kingSquare >= (side == SIDE_WHITE ? ChessCoord::G1 : ChessCoord::G8))
+            return SHORT_CASTLE_WING;
 
-        return shieldValue;
+        return NO_WING;
     }
 
-    // evaluates how strong the pawn shield around the king is for the black side by checking for pawns being in select locations
-    int blackKingShieldValue(int kingSquare, Bitboard friendlyPawnsBB)
+    // works out everything stored in the pawn hash table about the pawns of the position. this only has to be done the first time the pawns are seen
+    PawnHashTableEntry computePawnHashTableEntry(ChessPosition& position)
     {
-        int shieldValue = 0;
+        PawnHashTableEntry entry;
+        entry.pawnKey = position.pawnKey;
 
-        // if the king has long castled (or is otherwise on the west side of the board)
-        if (kingSquare <= ChessCoord::C8)
+        for (Colour side : { SIDE_WHITE, SIDE_BLACK })
         {
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::A7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::A6]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::B7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::B6]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::C7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-        }
+            Bitboard friendlyPawnsBB = position.getPieceBB(side, PAWN);
+            Bitboard enemyPawnsBB    = position.getPieceBB(!side, PAWN);
 
-        // if the king has short castled (or is otherwise on the east side of the board)
-        else if (kingSquare >= ChessCoord::G8)
-        {
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::H7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::H6]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::G7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::G6]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
-            if (friendlyPawnsBB & BB::boardSquares[ChessCoord::F7]) shieldValue += KING_MIDGAME_PAWN_SHIELD_BONUS;
+            for (Bitboard pawnsBB = friendlyPawnsBB; pawnsBB; )
+            {
+                int square = BB::popLSB(pawnsBB);
+
+                // doubled/tripled pawns are pawns on the same file as another pawn of their side
+                if ((BB::fileMask[square % 8] & ~BB::boardSquares[square]) & friendlyPawnsBB)
+                    entry.doubledPawnsBB |= BB::boardSquares[square];
+
+                // isolated pawns have no pawns of their side on the files next to them
+                if (!(BB::adjacentFiles[square % 8] & friendlyPawnsBB))
+                    entry.isolatedPawnsBB |= BB::boardSquares[square];
+
+                // passed pawns have no enemy pawns on their file or the files next to them
+                if (!((BB::adjacentFiles[square % 8] | BB::fileMask[square % 8]) & enemyPawnsBB))
+                    entry.passedPawnsBB |= BB::boardSquares[square];
+
+                entry.pawnAttacksBB[side] |= MoveGeneration::pawnAttackLookupTable[side][square];
+            }
+
+            for (int wing = LONG_CASTLE_WING; wing <= SHORT_CASTLE_WING; wing++)
+                entry.kingShieldValues[side][wing] = KING_MIDGAME_PAWN_SHIELD_BONUS * countSetBits64(friendlyPawnsBB & kingShieldMasks[side][wing]);
         }
 
-        return shieldValue;
+        return entry;
+    }
+
+    // calculates the value of a side's pawns based on their structure. each pawn gets at most one of the doubled, blocked and isolated penalties
+    // (in that order). whether a pawn is blocked depends on the other pieces as well, so it is worked out here rather than stored in the pawn hash table
+    int evaluatePawnStructure(Colour side, ChessPosition& position, const PawnHashTableEntry& pawnEntry)
+    {
+        Bitboard friendlyPawnsBB = position.getPieceBB(side, PAWN);
+        Bitboard blockedPawnsBB  = friendlyPawnsBB & (side == SIDE_WHITE ? BB::southOne(position.occupiedBB) : BB::northOne(position.occupiedBB));
+
+        Bitboard doubledPawnsBB  = friendlyPawnsBB & pawnEntry.doubledPawnsBB;
+        blockedPawnsBB          &= ~doubledPawnsBB;
+        Bitboard isolatedPawnsBB = friendlyPawnsBB & pawnEntry.isolatedPawnsBB & ~doubledPawnsBB & ~blockedPawnsBB;
+
+        return PAWN_PASSED_BONUS * countSetBits64(friendlyPawnsBB & pawnEntry.passedPawnsBB) - PAWN_DOUBLED_PENALTY * countSetBits64(doubledPawnsBB) -
+               BLOCKED_PAWN_PENALTY * countSetBits64(blockedPawnsBB) - PAWN_ISOLATED_PENALTY * countSetBits64(isolatedPawnsBB);
     }
 
     // evaluates the structual position of a bishop
@@ -232,7 +314,7 @@ namespace Eval
     }
 
     // evaluates the structural position of knights
-    inline int knightStructureValue(Byte square, Colour side, Bitboard friendlyPawnsBB, Bitboard enemyPawnsBB)
+    inline int knightStructureValue(Byte square, Colour side, Bitboard enemyPawnsBB, const PawnHashTableEntry& pawnEntry)
     {
         int structureValue = 0;
 
@@ -260,36 +342,6 @@ namespace Eval
                         structureValue -= MINOR_TRAPPED_KNIGHT_PENALTY; 
                     break;
             }
-
-            // outposts
-            // make sure the knight is on the fourth, fifth, sixth, or seventh rank
-            if (square >= ChessCoord::A4 && square <= ChessCoord::H7)
-            {
-                bool isProtected = false;
-                bool isAttacked = false;
-
-                // if the knight is not on the A file
-                if (square % 8 > 0)
-                {
-                    if (BB::boardSquares[square - 9] & friendlyPawnsBB)
-                        isProtected = true;
-                    if (BB::boardSquares[square + 9] & enemyPawnsBB)
-                        isAttacked = true;
-                }
-
-                // if the knight is not on the H file
-                if (square % 8 < 7)
-                {
-                    if (BB::boardSquares[square - 7] & friendlyPawnsBB)
-                        isProtected = true;
-                    if (BB::boardSquares[square + 7] & enemyPawnsBB)
-                        isAttacked = true;
-                }
-
-                // if the knight is protected and not attacked, then the knight is an outpost
-                if (isProtected && isAttacked)
-                    structureValue += OUTPOST_BONUS;
-            }
         }
         else
         {
@@ -312,47 +364,22 @@ namespace Eval
                         structureValue -= MINOR_TRAPPED_KNIGHT_PENALTY; 
                     break;
             }
-
-            // outposts
-            // make sure the knight is on the fourth, fifth, sixth, or seventh rank
-            if (square >= ChessCoord::A2 && square <= ChessCoord::H5)
-            {
-                bool isProtected = false;
-                bool isAttacked = false;
-
-                // if the knight is not on the A file
-                if (square % 8 > 0)
-                {
-                    if (BB::boardSquares[square + 9] & friendlyPawnsBB)
-                        isProtected = true;
-                    if (BB::boardSquares[square - 9] & enemyPawnsBB)
-                        isAttacked = true;
-                }
-
-                // if the knight is not on the H file
-                if (square % 8 < 7)
-                {
-                    if (BB::boardSquares[square + 7] & friendlyPawnsBB)
-                        isProtected = true;
-                    if (BB::boardSquares[square - 7] & enemyPawnsBB)
-                        isAttacked = true;
-                }
-
-                // if the knight is protected and not attacked, then the knight is an outpost
-                if (isProtected && isAttacked)
-                    structureValue += OUTPOST_BONUS;
-            }
         }
 
-        // knights lose value as the number of pawns on the board decreases
-        structureValue += KNIGHT_PAWN_COUNT_ADJUSTMENT[countSetBits64(friendlyPawnsBB)];
+        // outposts
+        // make sure the knight is on the fourth, fifth, sixth, or seventh rank (from its side's point of view)
+        bool onOutpostRank = side == SIDE_WHITE ? (square >= ChessCoord::A4 && square <= ChessCoord::H7) : (square >= ChessCoord::A2 && square <= ChessCoord::H5);
+
+        // if the knight is protected by a pawn and not attacked by an enemy pawn, then the knight is an outpost
+        if (onOutpostRank && (pawnEntry.pawnAttacksBB[side] & BB::boardSquares[square]) && !(pawnEntry.pawnAttacksBB[!side] & BB::boardSquares[square]))
+            structureValue += OUTPOST_BONUS;
 
         return structureValue;
     }
 
     // evaluates the structural position of the king during the midgame
     // it should be noted that the piece square tables already accomodate for pawn shields in the midgame
-    int kingMidgameStructureValue(int square, Colour side, Bitboard friendlyPiecesBB, Bitboard friendlyPawnsBB)
+    int kingMidgameStructureValue(int square, Colour side, Bitboard friendlyPiecesBB, const PawnHashTableEntry& pawnEntry)
     {
         int structureValue = 0;
 
@@ -372,24 +399,13 @@ namespace Eval
         }
 
         // consider as well the strength of the pawn shield around the king
-        structureValue += side == SIDE_WHITE ? whiteKingShieldValue(square, friendlyPawnsBB) : blackKingShieldValue(square, friendlyPawnsBB);
+        ShieldWing wing = getShieldWing(square, side);
+        if (wing != NO_WING)
+            structureValue += pawnEntry.kingShieldValues[side][wing];
 
         return structureValue;
     }
 
-    // evaluate the structual position of the king, using different weightings for various bonuses/penalties based on how far in the game is
-    int kingStructureValue(int square, int pstIndex, Colour side, Bitboard friendlyPiecesBB, Bitboard friendlyPawnsBB, float midgameValue)
-    {
-        // compute the value of the king's position if it were the midgame, then scale that weighting by how far into the game it is
-        int midgameValueScaled = pst::midgameKingTable[pstIndex] * midgameValue + 
-                                 kingMidgameStructureValue(square, side, friendlyPiecesBB, friendlyPawnsBB) * midgameValue;
-
-        // compute the value of the king's position if it were the endgame, then scale that weighting by how far into the game it is
-        int endgameValueScaled = pst::endgameKingTable[pstIndex] * (1 - midgameValue);
-
-        return midgameValueScaled + endgameValueScaled;
-    }
-
     // evaluates the structural position of a rook
     inline int rookStructureValue(int square, Bitboard occupiedBB, Bitboard friendlyPiecesBB, Bitboard enemyPiecesBB, Bitboard friendlyRooksBB)
     {
@@ -413,91 +429,92 @@ namespace Eval
     }
 
     // evaluates the position of the entire board
-    int evaluatePosition(Board* boardPtr, float midgameValue)
+    int evaluatePosition(Board* boardPtr, const MaterialHashTableEntry& material, PawnHashTable* pawnHashTable)
     {
-        ChessPosition& position = boardPtr->currentPosition;
-        
-        // initialize the white and black side's evaluation using the evaluation for their pawn structures 
-        // as well as with a bonus if the side has a bishop pair
-        int whiteEval = evaluatePawnStructure(position.whitePawnsBB, position.blackPawnsBB, position);
-        int blackEval = evaluatePawnStructure(position.blackPawnsBB, position.whitePawnsBB, position);
+        // neither side can win if there is not enough material left to checkmate with
+        if (material.flags & MaterialHashTableEntry::INSUFFICIENT_MATERIAL)
+            return 0;
 
-        // bishop pair bonus
-        if (countSetBits64(position.whiteBishopsBB) == 2) whiteEval += BISHOP_PAIR_BONUS;
-        if (countSetBits64(position.blackBishopsBB) == 2) blackEval += BISHOP_PAIR_BONUS;
+        ChessPosition& position = boardPtr->currentPosition;
+        float midgameValue = material.midgameValue;
         
-        for (int square = 0; square < 64; square++)
+        // find what is known about the pawns in the pawn hash table, working it out (and storing it) if the pawns have not been seen before
+        // (if no pawn hash table is given, it is always worked out from scratch)
+        PawnHashTableEntry computedEntry;
+        const PawnHashTableEntry* pawnEntry = &computedEntry;
+        if (pawnHashTable)
         {
-            // if the square is empty, we need not consider it (it has no evaluation)
-            if (BB::boardSquares[square] & position.emptyBB)
-                continue;
+            PawnHashTableEntry& tableEntry = pawnHashTable->getEntry(position.pawnKey);
+            if (tableEntry.pawnKey != position.pawnKey)
+                tableEntry = computePawnHashTableEntry(position);
 
-            // the below if statements add to their respective side's total evaluation the worth of an individual piece based on their
-            // material value as well as their position and structure
-            if (BB::boardSquares[square] & boardPtr->currentPosition.whitePiecesBB)
-            {
-                if (BB::boardSquares[square] & position.whitePawnsBB)        whiteEval += PAWN_VALUE + pst::pawnTable[63 - square];
-                else if (BB::boardSquares[square] & position.whiteKnightsBB) 
-                    whiteEval += KNIGHT_VALUE + pst::knightTable[63 - square] + knightStructureValue(square, SIDE_WHITE, position.whitePawnsBB, position.blackPawnsBB);
-                else if (BB::boardSquares[square] & position.whiteBishopsBB) 
-                    whiteEval += BISHOP_VALUE + pst::bishopTable[63 - square] + bishopStructureValue(square, SIDE_WHITE, position.whitePawnsBB, position.blackPawnsBB);
-                else if (BB::boardSquares[square] & position.whiteRooksBB)   whiteEval += ROOK_VALUE + pst::rookTable[63 - square] + rookStructureValue(square, position.occupiedBB, position.whitePiecesBB, position.blackPiecesBB, position.whiteRooksBB);
-                else if (BB::boardSquares[square] & position.whiteQueensBB)  whiteEval += QUEEN_VALUE + pst::queenTable[63 - square];
-                else if (BB::boardSquares[square] & position.whiteKingBB)
-                    // so a pawn hash table is just a transposition table but for pawn structures??
-                    whiteEval += KING_VALUE + kingStructureValue(square, 63 - square, SIDE_WHITE, position.whitePiecesBB, position.whitePawnsBB, midgameValue);
-            }
-            else
-            {
-                if (BB::boardSquares[square] & position.blackPawnsBB)        blackEval += PAWN_VALUE + pst::pawnTable[square];
-                else if (BB::boardSquares[square] & position.blackKnightsBB)
-                    blackEval += KNIGHT_VALUE + pst::knightTable[square] + knightStructureValue(square, SIDE_BLACK, position.blackPawnsBB, position.whitePawnsBB);
-                else if (BB::boardSquares[square] & position.blackBishopsBB)
-                    blackEval += BISHOP_VALUE + pst::bishopTable[square] + bishopStructureValue(square, SIDE_BLACK, position.blackPawnsBB, position.whitePawnsBB);
-                else if (BB::boardSquares[square] & position.blackRooksBB)   blackEval += ROOK_VALUE + pst::rookTable[square] + rookStructureValue(square, position.occupiedBB, position.blackPiecesBB, position.whitePiecesBB, position.blackRooksBB);
-                else if (BB::boardSquares[square] & position.blackQueensBB)  blackEval += QUEEN_VALUE + pst::queenTable[square];
-                else if (BB::boardSquares[square] & position.blackKingBB)
-                    blackEval += KING_VALUE + kingStructureValue(square, square, SIDE_BLACK, position.blackPiecesBB, position.blackPawnsBB, midgameValue);
-            }
+            pawnEntry = &tableEntry;
         }
+        else
+            computedEntry = computePawnHashTableEntry(position);
+
+        // initialize the white and black side's evaluation using the evaluation for their pawn structures 
+        int whiteEval = evaluatePawnStructure(SIDE_WHITE, position, *pawnEntry);
+        int blackEval = evaluatePawnStructure(SIDE_BLACK, position, *pawnEntry);
+
+        // the material and square piece table values of all the pieces are already summed up by the position, so they only need
+        // to be blended by how far into the game it is (the bonuses that only depend on the numbers of pieces, like the bishop pair
+        // bonus, come from the material hash table). only the structure of the pieces has to be looked at here
+        int eval = position.midgameScore * midgameValue + position.endgameScore * (1 - midgameValue);
+
+        for (Bitboard knightsBB = position.whiteKnightsBB; knightsBB;)
+            whiteEval += knightStructureValue(BB::popLSB(knightsBB), SIDE_WHITE, position.blackPawnsBB, *pawnEntry);
+        for (Bitboard knightsBB = position.blackKnightsBB; knightsBB;)
+            blackEval += knightStructureValue(BB::popLSB(knightsBB), SIDE_BLACK, position.whitePawnsBB, *pawnEntry);
+
+        for (Bitboard bishopsBB = position.whiteBishopsBB; bishopsBB;)
+            whiteEval += bishopStructureValue(BB::popLSB(bishopsBB), SIDE_WHITE, position.whitePawnsBB, position.blackPawnsBB);
+        for (Bitboard bishopsBB = position.blackBishopsBB; bishopsBB;)
+            blackEval += bishopStructureValue(BB::popLSB(bishopsBB), SIDE_BLACK, position.blackPawnsBB, position.whitePawnsBB);
+
+        for (Bitboard rooksBB = position.whiteRooksBB; rooksBB;)
+            whiteEval += rookStructureValue(BB::popLSB(rooksBB), position.occupiedBB, position.whitePiecesBB, position.blackPiecesBB, position.whiteRooksBB);
+        for (Bitboard rooksBB = position.blackRooksBB; rooksBB;)
+            blackEval += rookStructureValue(BB::popLSB(rooksBB), position.occupiedBB, position.blackPiecesBB, position.whitePiecesBB, position.blackRooksBB);
+
+        // the structure around the king only matters in the midgame, so it is scaled by how far into the game it is
+        whiteEval += kingMidgameStructureValue(BB::getLSB(position.whiteKingBB), SIDE_WHITE, position.whitePiecesBB, *pawnEntry) * midgameValue;
+        blackEval += kingMidgameStructureValue(BB::getLSB(position.blackKingBB), SIDE_BLACK, position.blackPiecesBB, *pawnEntry) * midgameValue;
         
-        return whiteEval - blackEval;
+        return eval + material.imbalance + whiteEval - blackEval;
     }
 
     // see (static search evaluation) determines if an exchange of pieces on a certain square is winning or losing
     // note that this function does not consider if a move would result in a check (making it not wholly accurate)
-    int see(Board* boardPtr, Byte square, Colour attackingSide, int currentSquareValue)
+    // the attacking side is a template parameter, as it simply alternates with each recapture (and so is known at compile time)
+    // the pieces that have already taken part in the exchange are kept track of in a bitboard, rather than being removed from the position,
+    // so that the board is never changed (and can be read by anything else while the exchange is being evaluated)
+    template <Colour attackingSide>
+    int see(Board* boardPtr, Byte square, int currentSquareValue, Bitboard usedAttackersBB)
     {
         // find the information about the least valuable attacker currently attacking the square
         int pieceValue;
-        Bitboard* pieceBB = nullptr;
-        Bitboard  attacksToSquareBB;
-        boardPtr->getLeastValuableAttacker(square, attackingSide, &pieceValue, &pieceBB, &attacksToSquareBB);
+        Bitboard attacksToSquareBB = boardPtr->getLeastValuableAttackers<attackingSide>(square, usedAttackersBB, &pieceValue);
         
-        // if there is no piece bitboard, then there was no attacker found, and the square is no longer attacked
-        if (!pieceBB)
+        // if there are no attackers left, then the square is no longer attacked
+        if (!attacksToSquareBB)
             return -currentSquareValue;
         else
         {
             // checks if the exchange is winning (if material would be gained)
-            if (pieceValue < currentSquareValue || !attacksToSquareBB)
+            if (pieceValue < currentSquareValue)
                 return currentSquareValue - pieceValue;
             
             // otherwise, if the exchange is losing, see if we would eventually win it down the line
+            // (the attacker that captures is taken out of the potential list of attackers for the rest of the exchange)
             else
-            {
-                // removes the attacker from the potential list of attackers
-                int lsb = BB::getLSB(attacksToSquareBB);
-                *pieceBB &= ~BB::boardSquares[lsb];
-
-                // search until we know for sure whether or not we'd eventually win the exchange
-                int score = -Eval::see(boardPtr, square, !attackingSide, pieceValue);
-
-                // adds the attacker back to the potential list of attackers
-                *pieceBB |= BB::boardSquares[lsb];
-
-                return score;
-            }
+                return -see<!attackingSide>(boardPtr, square, pieceValue, usedAttackersBB | BB::boardSquares[BB::getLSB(attacksToSquareBB)]);
         }
     }
+
+    // the side that starts the exchange is only known at runtime, so it is branched on once here
+    int see(Board* boardPtr, Byte square, Colour attackingSide, int currentSquareValue)
+    {
+        return attackingSide == SIDE_WHITE ? see<SIDE_WHITE>(boardPtr, square, currentSquareValue, 0) : see<SIDE_BLACK>(boardPtr, square, currentSquareValue, 0);
+    }
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "Bitboard.h"
 #include "DataTypes.h"
+#include "ZobristKey.h"
 
 // this declaration is necessary to prevent circular including
 class Board;
@@ -17,13 +21,113 @@ namespace Eval
     const int KNIGHT_VALUE = 350;
     const int PAWN_VALUE   = 100;
 
+    // the values above indexed by PieceType (with a value of 0 for NO_PIECE)
+    const int PIECE_VALUES[7] = { PAWN_VALUE, KNIGHT_VALUE, BISHOP_VALUE, ROOK_VALUE, QUEEN_VALUE, KING_VALUE, 0 };
+
     const int CHECKMATE_VALUE = 1000000;
 
+    // the number of pieces that a game starts with
+    const int MAX_PIECES = 32;
+
+    // the material value plus the square piece table value of each side's pieces on each square (indexed by side, PieceType and square),
+    // for the midgame and for the endgame. the values are from white's point of view, so all of black's values are negative
+    extern const std::array<std::array<std::array<int, 64>, 6>, 2> midgamePieceSquareValues;
+    extern const std::array<std::array<std::array<int, 64>, 6>, 2> endgamePieceSquareValues;
+
+    // the default size of the pawn hash table (in megabytes), which can be changed with the "PawnHash" UCI option
+    const int DEFAULT_PAWN_HASH_SIZE = 16;
+
+    // stores what the evaluation needs to know about the pawns of both sides, so that it does not have to be worked out again when the same
+    // pawns are seen later. only things that depend on nothing but the pawns are stored, as the entry is found by the position's pawn key
+    // (a default entry, with a key of 0, is correct for a position with no pawns). each entry fills exactly one cache line
+    struct alignas(64) PawnHashTableEntry
+    {
+        ZobristKey::zkey pawnKey = 0;
+
+        // the pawns (of either side) that share their file with another pawn of their side, that have no pawns of their side on
+        // the files next to them, and that have no enemy pawns on their file or the files next to them
+        Bitboard doubledPawnsBB  = 0;
+        Bitboard isolatedPawnsBB = 0;
+        Bitboard passedPawnsBB   = 0;
+
+        // the squares attacked by each side's pawns
+        Bitboard pawnAttacksBB[2] = { 0, 0 };
+
+        // the value of each side's pawn shield on each wing of the board (indexed by side, then by ShieldWing)
+        int kingShieldValues[2][2] = { { 0, 0 }, { 0, 0 } };
+    };
+
+    // each search has its own pawn hash table (rather than sharing one), so that searches can run on more than one thread at once.
+    // the number of entries is a power of two, so that the index of a pawn key is found with a mask rather than a modulo
+    struct PawnHashTable
+    {
+        std::vector<PawnHashTableEntry> entries;
+        ZobristKey::zkey mask;
+
+        PawnHashTable();
+        void resize(int sizeMB);
+        void clear();
+
+        PawnHashTableEntry& getEntry(ZobristKey::zkey pawnKey) { return entries[pawnKey & mask]; }
+    };
+
+    // the material key of a position packs the number of each side's pawns, knights, bishops, rooks and queens into 6 bits each (kings are
+    // not counted, as each side always has one). adding a piece to the position adds its increment to the key, and removing it subtracts it.
+    // the two kings leave at most 62 squares for any one type of piece, so a count never carries over into the count next to it
+    const int MATERIAL_KEY_COUNT_BITS = 6;
+
+    constexpr uint64_t getMaterialKeyIncrement(Colour side, PieceType piece) { return piece == KING ? 0 : 1ULL << ((side * 5 + piece) * MATERIAL_KEY_COUNT_BITS); }
+    constexpr int getPieceCount(uint64_t materialKey, Colour side, PieceType piece) 
+    { 
+        return (materialKey >> ((side * 5 + piece) * MATERIAL_KEY_COUNT_BITS)) & ((1 << MATERIAL_KEY_COUNT_BITS) - 1); 
+    }
+
+    // the 10 counts only use the lowest 60 bits, so no position can have a material key with every bit set, which marks an empty material hash table entry
+    const uint64_t EMPTY_MATERIAL_KEY = ~0ULL;
+
+    // stores everything that the evaluation and search need to know that only depends on how many of each type of piece each side has.
+    // there are few enough of these that each one is only ever worked out once per search, and then found in the material hash table
+    struct MaterialHashTableEntry
+    {
+        uint64_t materialKey = EMPTY_MATERIAL_KEY;
+
+        // how far into the game the position is (see getMidgameValue)
+        float midgameValue = 0;
+
+        // the bonuses and penalties that come from the numbers of pieces alone (from white's point of view)
+        int imbalance = 0;
+
+        Byte flags = 0;
+
+        enum Flags : Byte
+        {
+            // neither side has enough material left to checkmate (a lone king, or a king and a single minor piece against a lone king)
+            INSUFFICIENT_MATERIAL = 1 << 0,
+
+            // the side has nothing left but its king and pawns (so it is likely to be in zugzwang)
+            WHITE_PAWNS_ONLY = 1 << 1,
+            BLACK_PAWNS_ONLY = 1 << 2,
+        };
+
+        bool hasPawnsOnly(Colour side) const { return flags & (side == SIDE_WHITE ? WHITE_PAWNS_ONLY : BLACK_PAWNS_ONLY); }
+    };
+
+    // like the pawn hash table, each search has its own material hash table. its entries never become out of date (they only depend on the
+    // material key), so it does not need to be cleared between searches
+    struct MaterialHashTable
+    {
+        std::vector<MaterialHashTableEntry> entries;
+
+        MaterialHashTable();
+        const MaterialHashTableEntry& probe(uint64_t materialKey);
+    };
+
+    uint64_t computeMaterialKey(ChessPosition& position);
+    MaterialHashTableEntry computeMaterialHashTableEntry(uint64_t materialKey);
+
     int evaluateBoardRelativeTo(Colour side, int eval);
-    int evaluatePosition(Board* boardPtr, float midgameValue);
+    int evaluatePosition(Board* boardPtr, const MaterialHashTableEntry& material, PawnHashTable* pawnHashTable = nullptr);
 
-    float getMidgameValue(Bitboard occupiedBB);
+    float getMidgameValue(int numPieces);
     int see(Board* boardPtr, Byte square, Colour attackingSide, int currentSquareValue);
-    
-    void init();
 }
@@ -14,6 +14,7 @@ enum class CastlingPrivilege
 
 // this enum defines the possible types of moves the move can be
 // it is used for the sake of making/unmaking moves, as some moves can require special handling
+// it is stored in 4 bits of a Move, so there can be no more than 16 values
 enum class MoveType
 {
     CAPTURE,
@@ -27,68 +28,62 @@ enum class MoveType
     BISHOP_PROMO,
     KNIGHT_PROMO,
     EN_PASSANT_SQUARE,
-    PAWN_PROMOTION,
-    CASTLE_HALF_MOVE,
 };
 
-// this structure contains all of the information for the engine's abstractions to fully make a move and unmake the same move
-// when the engine generates all of the possible moves, an array of type MoveData is returned
-struct MoveData
+/*
+    this structure contains all of the information for the engine's abstractions to fully make a move and unmake the same move,
+    packed into a single 32 bit integer:
+        bits 0-5:   the origin square
+        bits 6-11:  the target square
+        bits 12-14: the type of piece that moved
+        bits 15-17: the type of piece that was captured (NO_PIECE if the move is not a capture)
+        bits 18-21: the type of move (with values according to the MoveType enum above)
+        bit  22:    the side making the move
+
+    it contains no pointers or other data specific to a certain board, so a move can be stored anywhere (such as in the transposition table)
+    the parts of the position that a move cannot restore on its own (en passant square, castle privileges, fifty move counter) are 
+    instead kept in the board's BoardState history
+*/
+struct Move
 {
-    // stores the type of move that the move was (with values according to the enum above)
-    MoveType moveType = MoveType::INVALID;
-
-    /* pieceBB and colourBB must be pointers for the sake of incremental updating */
-
-    // a pointer to the Bitboard containing all of the same colour and type of piece as the piece moving 
-    Bitboard* pieceBB  = nullptr;
-
-    // a pointer to the Bitboard containing all of the same colour of pieces as the piece moving
-    Bitboard* colourBB = nullptr;
-
-    // a pointer to the Bitboard containing all of the same colour and type of piece as the piece that was captured 
-    // if this variable is nullptr, it indicates that the move does not involve a capture
-    Bitboard* capturedPieceBB = nullptr;
-
-    // a pointer to the Bitboard containing all of the same colour of pieces as the piece that was captured
-    Bitboard* capturedColourBB = nullptr;
-
-    // gets the integral coordinate of the square that has an en passant set on it (0-63)
-    // an en passant square value of >63 indicates that there are no en passant squares
-    Byte enPassantSquare = 100;
-
-    // stores which side is able to make the move
-    Colour side;
-
-    // contains the integral coordinate of where the piece was origianlly located (0-63)
-    Byte originSquare;
-
-    // contains the integral coordinate of where the piece went to (0-63)
-    Byte targetSquare;
-
-    // stores the value of the piece that moved
-    int pieceValue;
-
-    // stores the value of the piece that was captured
-    int capturedPieceValue;
-
-    // if any castle privileges were taken away during the move, the appropriate bits will be set in this variable as defined above 
-    // in the CastlePrivileges enum
-    Byte castlePrivilegesRevoked = 0;
-
-    // stores the weighting of the move in regards to prioritization. that is, this variable describes how early we should try to search
-    // this move. a high value indicates more urgency
-    int moveScore = 0;
-
-    // contains the number of full-moves since the last pawn move or piece capture 
-    Byte fiftyMoveCounter;
+    uint32_t data;
+
+    Byte originSquare()        const { return data & 0x3f;                         }
+    Byte targetSquare()        const { return (data >> 6) & 0x3f;                  }
+    PieceType piece()          const { return (PieceType)((data >> 12) & 0x7);     }
+    PieceType capturedPiece()  const { return (PieceType)((data >> 15) & 0x7);     }
+    MoveType moveType()        const { return (MoveType)((data >> 18) & 0xf);      }
+    Colour side()              const { return (data >> 22) & 0x1;                  }
+
+    bool isNull()      const { return data == 0;                  }
+    bool isCapture()   const { return capturedPiece() != NO_PIECE; }
+    bool isCastle()    const { return moveType() == MoveType::SHORT_CASTLE || moveType() == MoveType::LONG_CASTLE;  }
+    bool isPromotion() const { return moveType() >= MoveType::QUEEN_PROMO && moveType() <= MoveType::KNIGHT_PROMO; }
+
+    // returns the type of piece that a pawn turns into with this move (only valid if the move is a promotion)
+    PieceType promotionPiece() const
+    {
+        switch (moveType())
+        {
+            case MoveType::QUEEN_PROMO:  return QUEEN;
+            case MoveType::ROOK_PROMO:   return ROOK;
+            case MoveType::BISHOP_PROMO: return BISHOP;
+            default:                     return KNIGHT;
+        }
+    }
 
     // compare two moves to see if they are the same 
-    bool operator==(MoveData& rightMD)
+    bool operator==(const Move& rightMove) const { return data == rightMove.data; }
+    bool operator!=(const Move& rightMove) const { return data != rightMove.data; }
+
+    // packs all of the information about a move into a new Move
+    static Move create(Byte originSquare, Byte targetSquare, PieceType piece, PieceType capturedPiece, MoveType moveType, Colour side)
     {
-        return originSquare == rightMD.originSquare && targetSquare == rightMD.targetSquare &&
-               pieceBB == rightMD.pieceBB && colourBB == rightMD.colourBB &&
-               capturedPieceBB == rightMD.capturedPieceBB && enPassantSquare == rightMD.enPassantSquare &&
-               castlePrivilegesRevoked == rightMD.castlePrivilegesRevoked && moveType == rightMD.moveType;
+        Move move;
+        move.data = originSquare | (targetSquare << 6) | (piece << 12) | (capturedPiece << 15) | ((uint32_t)moveType << 18) | ((uint32_t)side << 22);
+        return move;
     }
-};
\ No newline at end of file
+};
+
+// a move with all of its bits unset. no real move can have this value, as it would have the same origin and target square
+const Move NULL_MOVE = { 0 };
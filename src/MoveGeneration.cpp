@@ -1,8 +1,16 @@
+#include <array>
+#include <cstdlib>
 #include <iostream>
+#include <random>
 
 #include "Board.h"
 #include "Constants.h"
 #include "MoveGeneration.h"
+#include "utils.h"
+
+#if ATHENA_PEXT && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
 
 namespace MoveGeneration
 {
@@ -19,24 +27,63 @@ namespace MoveGeneration
         NUM_DIRECTIONS,
     };
 
-    // each element consists of an array of 64 Bitboards, each of which masks all the bits in one direction starting from a certain square
-    Bitboard rays[NUM_DIRECTIONS][64];
+    SlidingAttackEntry rookAttackEntries[64]   {};
+    SlidingAttackEntry bishopAttackEntries[64] {};
 
-    /* initialize all of the global variables defined in MoveGeneration.h so that they may be used elsewhere by the engine */
+    // the attack tables that the sliding attack entries point into. the sizes are the sum of 2^(bits in the mask) over all 64 squares
+    Bitboard rookAttackTable[102400];
+    Bitboard bishopAttackTable[5248];
 
-    extern Bitboard pawnAttackLookupTable[2][64] { { 0 }, { 0 } };
-    extern Bitboard knightLookupTable[64]        { 0 };
-    extern Bitboard kingLookupTable[64]          { 0 };
+    // magic numbers for each square, found by trial with a sparse random number generator
+    const Bitboard rookMagics[64] =
+    {
+        0x1080004008801020ULL, 0x0840092002c03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+        0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+        0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+        0x000a001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+        0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021d00100ULL,
+        0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000a0001768104ULL,
+        0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+        0x0442000a00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040a00128541ULL,
+        0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+        0x0400802402800800ULL, 0xc100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+        0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000a0020ULL,
+        0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+        0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040a00300ULL, 0x0801100280080480ULL,
+        0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+        0x0000209300488001ULL, 0x04c1002414824001ULL, 0x020020000b001041ULL, 0x7000100004200901ULL,
+        0x8002002004100802ULL, 0x30010002084c0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL,
+    };
 
-    // initializes the rays table
-    void initRays()
+    const Bitboard bishopMagics[64] =
+    {
+        0xa010041108003100ULL, 0x006082020a002900ULL, 0x6810010619200000ULL, 0x08281a0520000408ULL,
+        0x0001104001000400ULL, 0x0018901008048400ULL, 0x00040a0210245280ULL, 0x000200210808a402ULL,
+        0x9140048410821200ULL, 0x0800091010820041ULL, 0x20504804832202c0ULL, 0x0100091401081000ULL,
+        0x8021011140000012ULL, 0x0810020804450400ULL, 0x208b0542109008a2ULL, 0x0080084a08040204ULL,
+        0x0040e2a80811244cULL, 0x2505022008008108ULL, 0x0430220100420040ULL, 0x010a040420220040ULL,
+        0x1105000290400000ULL, 0x0093001200822120ULL, 0x4000a62048043004ULL, 0x280120048a015004ULL,
+        0x006090002a020814ULL, 0x44042000240800d0ULL, 0x01102800040a4400ULL, 0x1004080080220040ULL,
+        0x0001001011004024ULL, 0x0010044000805040ULL, 0x0914041200820100ULL, 0x0004821012821480ULL,
+        0x0024040500c05021ULL, 0x0088611002080200ULL, 0x0116080a00040020ULL, 0x4000020080080080ULL,
+        0x2450450140840040ULL, 0x0000880201484100ULL, 0x0222020404020092ULL, 0x8081110600002e00ULL,
+        0x2842101105000801ULL, 0x1100809008001025ULL, 0x00020202221c0400ULL, 0x0422014022009020ULL,
+        0x0210046102100c00ULL, 0xc004008082029102ULL, 0x00aa461801101200ULL, 0x0404080080201108ULL,
+        0x020542108c205002ULL, 0x0410544804100100ULL, 0x0040910841100000ULL, 0x0400200042021100ULL,
+        0x00004204850400c0ULL, 0x0200100410a42102ULL, 0x1040020801210102ULL, 0x0805040410420000ULL,
+        0x2884804130100200ULL, 0x800c262201242000ULL, 0x1058000194108800ULL, 0x0014221054420204ULL,
+        0x0104000012a02200ULL, 0x0200881003300100ULL, 0x0140400202840100ULL, 0x0402020801010201ULL,
+    };
+
+    /* the lookup tables of the non sliding pieces and the tables of lines between squares are all generated at compile time */
+
+    // each element consists of an array of 64 Bitboards, each of which masks all the bits in one direction starting from a certain square
+    constexpr std::array<std::array<Bitboard, 64>, NUM_DIRECTIONS> rays = []
     {
+        std::array<std::array<Bitboard, 64>, NUM_DIRECTIONS> rays {};
+
         for (int fromSquare = 0; fromSquare < 64; fromSquare++)
         {
-            // clear all the bits of the Bitboard before setting any
-            for (int dir = 0; dir < NUM_DIRECTIONS; dir++)
-                rays[dir][fromSquare] = 0;
-
             // set the bits for the cardinal directions
             for (int square = fromSquare + 8; square <= 63; square += 8)
                 rays[DIR_NORTH][fromSquare] |= BB::boardSquares[square];
@@ -60,81 +107,163 @@ namespace MoveGeneration
             for (int square = fromSquare - 9; square >= 0 && (square - 1) % 8 != 6; square -= 9)
                 rays[DIR_SOUTHEAST][fromSquare] |= BB::boardSquares[square];
         }
-    }
 
-    // initializes the knight pseudomove lookup table
-    void initKnightLT(Byte knightLoc)
+        return rays;
+    }();
+
+    // the direction pointing the opposite way of each direction (in the order of the Directions enum)
+    // note that the south-west and south-east rays are named after the way they step through the squares (-7 and -9), so they
+    // point the opposite way of the north-west (+7) and north-east (+9) rays respectively
+    constexpr int oppositeDirections[NUM_DIRECTIONS] = { DIR_SOUTH, DIR_NORTH, DIR_WEST, DIR_EAST, DIR_SOUTHEAST, DIR_SOUTHWEST, DIR_NORTHEAST, DIR_NORTHWEST };
+
+    // the squares between two squares are the ray from the origin square towards the target square, minus the ray from the target square 
+    // in the same direction (which covers everything past it) and the target square itself
+    extern constexpr std::array<std::array<Bitboard, 64>, 64> squaresBetween = []
     {
-        // these bitboards clear a certain file as to prevent bits overflowwing into ranks they shouldn't
-        Bitboard knightAFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_A];
-        Bitboard knightBFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_B];
-        Bitboard knightGFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_G];
-        Bitboard knightHFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_H];
+        std::array<std::array<Bitboard, 64>, 64> between {};
 
-        Bitboard movesBB = 0;
+        for (int fromSquare = 0; fromSquare < 64; fromSquare++)
+            for (int dir = 0; dir < NUM_DIRECTIONS; dir++)
+                for (int toSquare = 0; toSquare < 64; toSquare++)
+                    if (rays[dir][fromSquare] & BB::boardSquares[toSquare])
+                        between[fromSquare][toSquare] = (rays[dir][fromSquare] ^ rays[dir][toSquare]) & ~BB::boardSquares[toSquare];
 
-        // add western horizontal moves
-        movesBB |= (knightAFileClearedBB & knightBFileClearedBB) << 6 | (knightAFileClearedBB & knightBFileClearedBB) >> 10;
+        return between;
+    }();
 
-        // add western vertical moves
-        movesBB |= knightAFileClearedBB << 15 | knightAFileClearedBB >> 17;
+    // the line through two squares is the rays from the origin square in both the direction of the target square and the opposite direction
+    extern constexpr std::array<std::array<Bitboard, 64>, 64> squaresInLine = []
+    {
+        std::array<std::array<Bitboard, 64>, 64> lines {};
 
-        // add eastern horizontal moves                                                 
-        movesBB |= (knightGFileClearedBB & knightHFileClearedBB) << 10 | (knightGFileClearedBB & knightHFileClearedBB) >> 6;
+        for (int fromSquare = 0; fromSquare < 64; fromSquare++)
+            for (int dir = 0; dir < NUM_DIRECTIONS; dir++)
+            {
+                Bitboard lineBB = rays[dir][fromSquare] | rays[oppositeDirections[dir]][fromSquare] | BB::boardSquares[fromSquare];
 
-        // add eastern vertical moves
-        movesBB |= knightHFileClearedBB << 17 | knightHFileClearedBB >> 15;                         
+                for (int toSquare = 0; toSquare < 64; toSquare++)
+                    if (rays[dir][fromSquare] & BB::boardSquares[toSquare])
+                        lines[fromSquare][toSquare] = lineBB;
+            }
 
-        knightLookupTable[knightLoc] = movesBB;
-    }
+        return lines;
+    }();
 
-    // initializes the king's pseudomove lookup table
-    void initKingLT(Byte kingLoc)
+    // the knight pseudomove lookup table
+    extern constexpr std::array<Bitboard, 64> knightLookupTable = []
     {
-        // for moves north west, west, and south west, we need to clear file a to prevent overflow
-        Bitboard kingAFileClearedBB = BB::boardSquares[kingLoc] & BB::fileClear[BB::FILE_A];
+        std::array<Bitboard, 64> lookupTable {};
+
+        for (int knightLoc = 0; knightLoc < 64; knightLoc++)
+        {
+            // these bitboards clear a certain file as to prevent bits overflowwing into ranks they shouldn't
+            Bitboard knightAFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_A];
+            Bitboard knightBFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_B];
+            Bitboard knightGFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_G];
+            Bitboard knightHFileClearedBB = BB::boardSquares[knightLoc] & BB::fileClear[BB::FILE_H];
 
-        // for moves north east, east, and south east, we need to clear file h to prevent overflow
-        Bitboard kingHFileClearedBB = BB::boardSquares[kingLoc] & BB::fileClear[BB::FILE_H];
+            Bitboard movesBB = 0;
 
-        // consider all ordinal and cardinal directions
-        kingLookupTable[kingLoc] = BB::northWestOne(kingAFileClearedBB) | BB::eastOne(kingAFileClearedBB) | 
+            // add western horizontal moves
+            movesBB |= (knightAFileClearedBB & knightBFileClearedBB) << 6 | (knightAFileClearedBB & knightBFileClearedBB) >> 10;
+
+            // add western vertical moves
+            movesBB |= knightAFileClearedBB << 15 | knightAFileClearedBB >> 17;
+
+            // add eastern horizontal moves                                                 
+            movesBB |= (knightGFileClearedBB & knightHFileClearedBB) << 10 | (knightGFileClearedBB & knightHFileClearedBB) >> 6;
+
+            // add eastern vertical moves
+            movesBB |= knightHFileClearedBB << 17 | knightHFileClearedBB >> 15;                         
+
+            lookupTable[knightLoc] = movesBB;
+        }
+
+        return lookupTable;
+    }();
+
+    // the king's pseudomove lookup table
+    extern constexpr std::array<Bitboard, 64> kingLookupTable = []
+    {
+        std::array<Bitboard, 64> lookupTable {};
+
+        for (int kingLoc = 0; kingLoc < 64; kingLoc++)
+        {
+            // for moves north west, west, and south west, we need to clear file a to prevent overflow
+            Bitboard kingAFileClearedBB = BB::boardSquares[kingLoc] & BB::fileClear[BB::FILE_A];
+
+            // for moves north east, east, and south east, we need to clear file h to prevent overflow
+            Bitboard kingHFileClearedBB = BB::boardSquares[kingLoc] & BB::fileClear[BB::FILE_H];
+
+            // consider all ordinal and cardinal directions
+            lookupTable[kingLoc] = BB::northWestOne(kingAFileClearedBB) | BB::eastOne(kingAFileClearedBB) | 
                                    BB::southWestOne(kingAFileClearedBB) | BB::northOne(BB::boardSquares[kingLoc]) |
                                    BB::northEastOne(kingHFileClearedBB) | BB::westOne(kingHFileClearedBB) | 
                                    BB::southEastOne(kingHFileClearedBB) | BB::southOne(BB::boardSquares[kingLoc]);
-    }
+        }
+
+        return lookupTable;
+    }();
 
-    // initializes the pawn pseudomove lookup table
-    void initPawnLT(Colour side, Byte pawnLoc)
+    // the pawn pseudomove lookup table
+    extern constexpr std::array<std::array<Bitboard, 64>, 2> pawnAttackLookupTable = []
     {
-        // clears the A file to prevent diagonal moves to the west causing overflow into another rank
-        Bitboard pawnAFileClearedBB = BB::boardSquares[pawnLoc] & BB::fileClear[BB::FILE_A];
+        std::array<std::array<Bitboard, 64>, 2> lookupTable {};
 
-        // clears the H file to prevent diagonal moves to the east causing overflow into another rank
-        Bitboard pawnHFileClearedBB = BB::boardSquares[pawnLoc] & BB::fileClear[BB::FILE_H];
+        for (int pawnLoc = 0; pawnLoc < 64; pawnLoc++)
+        {
+            // clears the A file to prevent diagonal moves to the west causing overflow into another rank
+            Bitboard pawnAFileClearedBB = BB::boardSquares[pawnLoc] & BB::fileClear[BB::FILE_A];
 
-        // set the diagonal attacks for the pawns
-        if (side == SIDE_WHITE)
-            pawnAttackLookupTable[SIDE_WHITE][pawnLoc] = BB::northWestOne(pawnAFileClearedBB) | BB::northEastOne(pawnHFileClearedBB);
-        else if (side == SIDE_BLACK)
-            pawnAttackLookupTable[SIDE_BLACK][pawnLoc] = BB::southWestOne(pawnAFileClearedBB) | BB::southEastOne(pawnHFileClearedBB);
-    }
+            // clears the H file to prevent diagonal moves to the east causing overflow into another rank
+            Bitboard pawnHFileClearedBB = BB::boardSquares[pawnLoc] & BB::fileClear[BB::FILE_H];
 
-    // initializes move generation
-    void init()
-    {
-        initRays();
+            // set the diagonal attacks for the pawns
+            lookupTable[SIDE_WHITE][pawnLoc] = BB::northWestOne(pawnAFileClearedBB) | BB::northEastOne(pawnHFileClearedBB);
+            lookupTable[SIDE_BLACK][pawnLoc] = BB::southWestOne(pawnAFileClearedBB) | BB::southEastOne(pawnHFileClearedBB);
+        }
+
+        return lookupTable;
+    }();
 
-        // initialize all of the lookup tables
-        for (int pieceLoc = 0; pieceLoc < 64; pieceLoc++)
+    // checks that the tables were generated correctly, by comparing a few entries that are easy to work out by hand (and every entry of
+    // the tables against each other). if anything is wrong, the engine does not compile
+    constexpr bool verifyLookupTables()
+    {
+        for (int square = 0; square < 64; square++)
         {
-            initKingLT(pieceLoc);
-            initKnightLT(pieceLoc);
-            initPawnLT(SIDE_BLACK, pieceLoc);
-            initPawnLT(SIDE_WHITE, pieceLoc);
+            // a piece can only attack a square that attacks it back with the same kind of move, and never its own square
+            for (int otherSquare = 0; otherSquare < 64; otherSquare++)
+            {
+                if (bool(knightLookupTable[square] & BB::boardSquares[otherSquare]) != bool(knightLookupTable[otherSquare] & BB::boardSquares[square]))
+                    return false;
+                if (bool(kingLookupTable[square] & BB::boardSquares[otherSquare]) != bool(kingLookupTable[otherSquare] & BB::boardSquares[square]))
+                    return false;
+                if (bool(pawnAttackLookupTable[SIDE_WHITE][square] & BB::boardSquares[otherSquare]) != bool(pawnAttackLookupTable[SIDE_BLACK][otherSquare] & BB::boardSquares[square]))
+                    return false;
+                if (squaresBetween[square][otherSquare] != squaresBetween[otherSquare][square] || squaresInLine[square][otherSquare] != squaresInLine[otherSquare][square])
+                    return false;
+            }
+
+            if ((knightLookupTable[square] | kingLookupTable[square]) & BB::boardSquares[square])
+                return false;
         }
+
+        return knightLookupTable[0]   == 0x0000000000020400ULL &&                    // a1: b3 and c2
+               knightLookupTable[63]  == 0x0020400000000000ULL &&                    // h8: g6 and f7
+               kingLookupTable[0]     == 0x0000000000000302ULL &&                    // a1: b1, a2 and b2
+               kingLookupTable[7]     == 0x000000000000c040ULL &&                    // h1: g1, g2 and h2
+               pawnAttackLookupTable[SIDE_WHITE][8]  == 0x0000000000020000ULL &&     // a2: b3
+               pawnAttackLookupTable[SIDE_BLACK][55] == 0x0000400000000000ULL &&     // h7: g6
+               squaresBetween[0][63]  == 0x0040201008040200ULL &&                    // a1 to h8: b2 through g7
+               squaresBetween[0][7]   == 0x000000000000007eULL &&                    // a1 to h1: b1 through g1
+               squaresBetween[0][10]  == 0 &&                                        // a1 and c2 do not share a line
+               squaresInLine[9][18]   == 0x8040201008040201ULL &&                    // b2 and c3: the a1-h8 diagonal
+               squaresInLine[7][14]   == 0x0102040810204080ULL;                      // h1 and g2: the h1-a8 diagonal
     }
 
+    static_assert(verifyLookupTables(), "the move generation lookup tables were not generated correctly");
+
     // computes the king's pseudo moves based on the positions of friendly pieces
     Bitboard computePseudoKingMoves(Byte fromSquare, Bitboard friendlyPiecesBB)
     {
@@ -151,7 +280,9 @@ namespace MoveGeneration
     }
 
     // computes the pawn's pseudo moves based on the positions of other pieces
-    Bitboard computePseudoPawnMoves(Byte fromSquare, Colour side, Bitboard enemyPiecesBB, Bitboard emptyBB, Byte enPassantSquare)
+    // the side is a template parameter, so the direction that the pawn moves in and its double step rank are known at compile time
+    template <Colour side>
+    Bitboard computePseudoPawnMoves(Byte fromSquare, Bitboard enemyPiecesBB, Bitboard emptyBB, Byte enPassantSquare)
     {
         // initialize the moves bitboard with the possible diagonal moves that the pawn can make
         // it's important to note that pawn's can only attack diagonally when an enemy occupies the square
@@ -161,28 +292,17 @@ namespace MoveGeneration
 
         // here we're adding the square in front of the pawn to its possibles moves, should it not be blocked by any other pieces
         // additionally, we add the square two in front of the pawn if it isn't blocked and the pawn was on its home rank
-        if (side == SIDE_WHITE)
-        {
-            Bitboard oneStepBB = BB::northOne(BB::boardSquares[fromSquare]) & emptyBB;
-
-            // if the twostep is on the fourth rank, it would mean the pawn was on its home rank
-            Bitboard twoStepBB = ((BB::northOne(oneStepBB)) & BB::rankMask[BB::RANK_FOURTH]) & emptyBB;
-            
-            movesBB |= oneStepBB | twoStepBB;
-        }
-        else if (side == SIDE_BLACK)
-        {
-            Bitboard oneStepBB = BB::southOne(BB::boardSquares[fromSquare]) & emptyBB;
-
-            // if the twostep is on the fifth rank, it would mean the pawn was on its home rank
-            Bitboard twoStepBB = ((BB::southOne(oneStepBB)) & BB::rankMask[BB::RANK_FIFTH]) & emptyBB;
+        Bitboard oneStepBB = BB::forwardOne<side>(BB::boardSquares[fromSquare]) & emptyBB;
 
-            movesBB |= oneStepBB | twoStepBB;
-        }
+        // if the twostep is on the fourth rank (from the side's point of view), it would mean the pawn was on its home rank
+        Bitboard twoStepBB = BB::forwardOne<side>(oneStepBB) & BB::rankMask[BB::relativeRank<side>(BB::RANK_FOURTH)] & emptyBB;
 
-        return movesBB;
+        return movesBB | oneStepBB | twoStepBB;
     }
 
+    template Bitboard computePseudoPawnMoves<SIDE_WHITE>(Byte fromSquare, Bitboard enemyPiecesBB, Bitboard emptyBB, Byte enPassantSquare);
+    template Bitboard computePseudoPawnMoves<SIDE_BLACK>(Byte fromSquare, Bitboard enemyPiecesBB, Bitboard emptyBB, Byte enPassantSquare);
+
     // this function sets a bit on the Bitboard according to the square passed into function if
     // the square was empty (meaning the sliding piece can move to it) or the square has an enemy
     // piece on it (meaning the sliding piece can capture it)
@@ -206,7 +326,8 @@ namespace MoveGeneration
 
     // Uses the classical approach to calculate rook (straight) moves
     // see more infomration on this implentation here: https://www.chessprogramming.org/Classical_Approach
-    Bitboard computePseudoRookMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    // this is only used to fill (and verify) the magic attack tables, as computePseudoRookMoves is much faster
+    Bitboard computeClassicalRookMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
     {
         // return immediately if the square that the piece is on is invalid (off the board)
         if (fromSquare > 64)
@@ -249,7 +370,8 @@ namespace MoveGeneration
     
     // Uses the classical approach to calculate bishop (diagonal) moves
     // see more infomration on this implentation here: https://www.chessprogramming.org/Classical_Approach
-    Bitboard computePseudoBishopMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    // this is only used to fill (and verify) the magic attack tables, as computePseudoBishopMoves is much faster
+    Bitboard computeClassicalBishopMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
     {
         // return immediately if the square that the piece is on is invalid (off the board)
         if (fromSquare > 64)
@@ -289,39 +411,204 @@ namespace MoveGeneration
         return movesBB & ~friendlyPiecesBB;
     }
 
-    // this function computes a queen's moves bitboard by simply ORING the moves that a rook and bishop could make from its square
-    Bitboard computePseudoQueenMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    // returns the relevant occupancy mask of a sliding piece: all of the squares along the given rays, minus the last square of each ray
+    // (a piece on the edge of the board can never block the slider from reaching any further squares, so it does not affect the attacks)
+    Bitboard computeSlidingMask(Byte square, const int* directions)
     {
-        return computePseudoBishopMoves(fromSquare, occupiedBB, friendlyPiecesBB) | computePseudoRookMoves(fromSquare, occupiedBB, friendlyPiecesBB);
+        Bitboard maskBB = 0;
+        for (int dir = 0; dir < 4; dir++)
+        {
+            Bitboard rayBB = rays[directions[dir]][square];
+            if (!rayBB)
+                continue;
+
+            // the rays going north or east grow towards the most significant bit, the rest towards the least significant bit
+            bool positiveRay = directions[dir] == DIR_NORTH || directions[dir] == DIR_EAST || 
+                               directions[dir] == DIR_NORTHEAST || directions[dir] == DIR_NORTHWEST;
+
+            maskBB |= rayBB & ~BB::boardSquares[positiveRay ? BB::getMSB(rayBB) : BB::getLSB(rayBB)];
+        }
+
+        return maskBB;
     }
 
-    // sets the castle privileges that a move will remove (for instance, a white piece taking a rook that hasn't moved
-    // would remove the black side from castling on that rook's side)
-    void setCastleMovePrivilegesRevoked(Colour side, Byte privileges, Byte* privilegesToBeRevoked)
+    // fills the attack table for one type of slider. every subset of each square's mask is enumerated using the carry-rippler trick
+    // (https://www.chessprogramming.org/Traversing_Subsets_of_a_Set) and its attacks are calculated with the classical approach
+    void initSlidingAttackEntries(SlidingAttackEntry* entries, Bitboard* attackTable, const Bitboard* magics, const int* directions,
+                                  Bitboard (*computeClassicalMoves)(Byte, Bitboard, Bitboard))
     {
-        if (side == SIDE_WHITE)
+        Bitboard* nextAttacks = attackTable;
+        for (int square = 0; square < 64; square++)
         {
-            if (privileges & (Byte)CastlingPrivilege::WHITE_LONG_CASTLE)  *privilegesToBeRevoked |= (Byte)CastlingPrivilege::WHITE_LONG_CASTLE;
-            if (privileges & (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE) *privilegesToBeRevoked |= (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE;
+            SlidingAttackEntry& entry = entries[square];
+            entry.mask    = computeSlidingMask(square, directions);
+            entry.magic   = magics[square];
+            entry.shift   = 64 - countSetBits64(entry.mask);
+            entry.attacks = nextAttacks;
+
+            Bitboard occupiedBB = 0;
+            do
+            {
+                entry.attacks[entry.index(occupiedBB)] = computeClassicalMoves(square, occupiedBB, 0);
+                occupiedBB = (occupiedBB - entry.mask) & entry.mask;
+            } while (occupiedBB);
+
+            // each square takes up 2^(number of bits in its mask) entries in the table
+            nextAttacks += (Bitboard)1 << (64 - entry.shift);
         }
-        else
+    }
+
+#if ATHENA_PEXT
+    // checks whether the processor running the engine has the BMI2 instructions (which an engine built with pext needs)
+    bool processorSupportsBMI2()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("bmi2");
+#else
+        // cpuid leaf 7 reports BMI2 support in bit 8 of the ebx register
+        int registers[4];
+        __cpuidex(registers, 7, 0);
+        return registers[1] & (1 << 8);
+#endif
+    }
+#endif
+
+    // returns the name of the method that the engine was built to index the sliding attack tables with
+    const char* getSlidingAttackBackendName()
+    {
+        return ATHENA_PEXT ? "pext" : "magic";
+    }
+
+    // initializes the attack tables for rooks and bishops, indexed in the way that the engine was built to look them up
+    void initSlidingAttacks()
+    {
+        const int rookDirections[4]   = { DIR_NORTH, DIR_SOUTH, DIR_EAST, DIR_WEST };
+        const int bishopDirections[4] = { DIR_NORTHEAST, DIR_NORTHWEST, DIR_SOUTHEAST, DIR_SOUTHWEST };
+
+        initSlidingAttackEntries(rookAttackEntries, rookAttackTable, rookMagics, rookDirections, computeClassicalRookMoves);
+        initSlidingAttackEntries(bishopAttackEntries, bishopAttackTable, bishopMagics, bishopDirections, computeClassicalBishopMoves);
+    }
+
+    // initializes move generation. the other lookup tables are generated at compile time, but the sliding attack tables are built when the
+    // engine starts. an engine built with pext cannot run without BMI2, so it stops here (with a message rather than an illegal instruction)
+    void init()
+    {
+#if ATHENA_PEXT
+        if (!processorSupportsBMI2())
         {
-            if (privileges & (Byte)CastlingPrivilege::BLACK_LONG_CASTLE)  *privilegesToBeRevoked |= (Byte)CastlingPrivilege::BLACK_LONG_CASTLE;
-            if (privileges & (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE) *privilegesToBeRevoked |= (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE;
+            std::cout << "info string this build of Athena uses pext, which this processor does not support (build it without ATHENA_PEXT)" << std::endl;
+            std::exit(1);
         }
+#endif
+
+        initSlidingAttacks();
     }
 
-    // calculates the castle moves that the given side can make according to its privileges
-    MoveData computeCastleMoveData(Colour side, Byte privileges, Bitboard occupiedBB, CastlingPrivilege castleType)
+    // compares the sliding attack lookups against the classical approach for every possible occupancy of every square's mask
+    // (with random pieces added outside of the mask as well, as they should never change the result)
+    // prints any mismatches and returns true if the two approaches agreed on every single occupancy
+    bool verifyCurrentSlidingAttacks()
+    {
+        std::mt19937_64 randomGenerator(0);
+        int occupanciesChecked = 0;
+        int mismatches = 0;
+
+        for (int square = 0; square < 64; square++)
+            for (int slider = 0; slider < 2; slider++)
+            {
+                bool isRook = slider == 0;
+                Bitboard maskBB = isRook ? rookAttackEntries[square].mask : bishopAttackEntries[square].mask;
+
+                Bitboard subsetBB = 0;
+                do
+                {
+                    Bitboard occupiedBB = subsetBB | (randomGenerator() & ~maskBB & ~BB::boardSquares[square]);
+                    Bitboard friendlyBB = randomGenerator() & occupiedBB;
+
+                    Bitboard magicBB     = isRook ? computePseudoRookMoves(square, occupiedBB, friendlyBB) 
+                                                  : computePseudoBishopMoves(square, occupiedBB, friendlyBB);
+                    Bitboard classicalBB = isRook ? computeClassicalRookMoves(square, occupiedBB, friendlyBB)
+                                                  : computeClassicalBishopMoves(square, occupiedBB, friendlyBB);
+
+                    if (magicBB != classicalBB)
+                    {
+                        mismatches++;
+                        std::cout << (isRook ? "rook" : "bishop") << " mismatch on square " << square << " with occupancy " << occupiedBB << std::endl;
+                    }
+
+                    occupanciesChecked++;
+                    subsetBB = (subsetBB - maskBB) & maskBB;
+                } while (subsetBB);
+            }
+
+        std::cout << getSlidingAttackBackendName() << " sliding attacks checked " << occupanciesChecked << " occupancies, " 
+                  << mismatches << " mismatches" << std::endl;
+        return mismatches == 0;
+    }
+
+    // compares the setwise sliding fills against looking up the attacks of each slider one at a time, for sets of sliders on random boards
+    // prints any mismatches and returns true if the two approaches agreed on every board
+    bool verifySetwiseSlidingAttacks()
     {
-        // setting the initial values for the move
-        MoveData md;
-        md.side = side;
+        std::mt19937_64 randomGenerator(0);
+        const int numBoards = 100000;
+        int mismatches = 0;
 
-        // note that setting the move type to regular here is necessary, as we can use the move type of the move 
-        // as a flag to see if the castle is legal
-        md.moveType = MoveType::REGULAR;
+        for (int i = 0; i < numBoards; i++)
+        {
+            // the boards get emptier as they go, so that both crowded and open positions are checked
+            Bitboard occupiedBB = randomGenerator() & randomGenerator() & (i % 2 ? randomGenerator() : ~Bitboard(0));
+            Bitboard orthogonalBB = occupiedBB & randomGenerator() & randomGenerator();
+            Bitboard diagonalBB   = occupiedBB & randomGenerator() & randomGenerator();
+
+            Bitboard expectedOrthogonalBB = 0, expectedDiagonalBB = 0;
+            for (Bitboard piecesBB = orthogonalBB; piecesBB; )
+                expectedOrthogonalBB |= computePseudoRookMoves(BB::popLSB(piecesBB), occupiedBB, 0);
+            for (Bitboard piecesBB = diagonalBB; piecesBB; )
+                expectedDiagonalBB |= computePseudoBishopMoves(BB::popLSB(piecesBB), occupiedBB, 0);
+
+            Bitboard orthogonalAttacksBB, diagonalAttacksBB;
+            BB::slidingAttacks(orthogonalBB, diagonalBB, ~occupiedBB, &orthogonalAttacksBB, &diagonalAttacksBB);
+
+            if (orthogonalAttacksBB != expectedOrthogonalBB || diagonalAttacksBB != expectedDiagonalBB)
+            {
+                mismatches++;
+                std::cout << "setwise mismatch with occupancy " << occupiedBB << ", orthogonal sliders " << orthogonalBB 
+                          << " and diagonal sliders " << diagonalBB << std::endl;
+            }
+        }
+
+        std::cout << (BB::useAVX2SlidingAttacks ? "avx2" : "scalar") << " setwise sliding attacks checked " << numBoards << " boards, " 
+                  << mismatches << " mismatches" << std::endl;
+        return mismatches == 0;
+    }
 
+    // verifies the attack tables (indexed in the way that the engine was built to look them up)
+    // the setwise fills are checked too, with and without avx2 (if the processor has it)
+    bool verifySlidingAttacks()
+    {
+        bool activeAVX2 = BB::useAVX2SlidingAttacks;
+
+        bool verified = verifyCurrentSlidingAttacks();
+
+        BB::useAVX2SlidingAttacks = false;
+        verified &= verifySetwiseSlidingAttacks();
+
+        if (activeAVX2)
+        {
+            BB::useAVX2SlidingAttacks = true;
+            verified &= verifySetwiseSlidingAttacks();
+        }
+
+        BB::useAVX2SlidingAttacks = activeAVX2;
+        return verified;
+    }
+
+    // calculates the castle moves that the given side can make according to its privileges
+    // returns NULL_MOVE if the side does not have the privileges for the castle, or if there are pieces in the way
+    Move computeCastleMove(Colour side, Byte privileges, Bitboard occupiedBB, CastlingPrivilege castleType)
+    {
         // these variables store the starting and ending square that the king must be able to move between to make a castle
         int lower, higher;
 
@@ -331,7 +618,6 @@ namespace MoveGeneration
             case CastlingPrivilege::WHITE_SHORT_CASTLE:
             case CastlingPrivilege::BLACK_SHORT_CASTLE:
             {
-
                 // check if the side to move has the privileges it needs to short castle
                 if (((privileges & (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE) && side == SIDE_WHITE) ||
                     (privileges & (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE) && side == SIDE_BLACK)
@@ -343,21 +629,10 @@ namespace MoveGeneration
                     // check if the squares in the bounds defined above are occupied, and if they are, do not allow the castle
                     for (int tile = lower; tile < higher; tile++)
                         if (BB::boardSquares[tile] & occupiedBB)
-                        {
-                            md.moveType = MoveType::INVALID;
-                            break;
-                        }
+                            return NULL_MOVE;
 
-                    // checks to see if the castle move is possible (it will be as long as the move's type hasn't been set to invalid)
-                    if (md.moveType != MoveType::INVALID)
-                    {
-                        md.moveType = MoveType::SHORT_CASTLE;
-                        setCastleMovePrivilegesRevoked(md.side, privileges, &md.castlePrivilegesRevoked);
-
-                        // sets the origin and square for the move for the king
-                        md.originSquare = lower - 1;
-                        md.targetSquare = higher - 1;
-                    }
+                    // the origin and target squares of the move are those of the king
+                    return Move::create(lower - 1, higher - 1, KING, NO_PIECE, MoveType::SHORT_CASTLE, side);
                 }
 
                 break;
@@ -378,399 +653,573 @@ namespace MoveGeneration
                     // check if the squares in the bounds defined above are occupied, and if they are, do not allow the castle
                     for (int tile = higher; tile > lower; tile--)
                         if (BB::boardSquares[tile] & occupiedBB)
-                        {
-                            md.moveType = MoveType::INVALID;
-                            break;
-                        }
-
-                    // checks to see if the castle move is possible (it will be as long as the move's type hasn't been set to invalid)
-                    if (md.moveType != MoveType::INVALID)
-                    {
-                        md.moveType = MoveType::LONG_CASTLE;
-                        setCastleMovePrivilegesRevoked(md.side, privileges, &md.castlePrivilegesRevoked);
+                            return NULL_MOVE;
 
-                        // sets the origin and square for the move for the king
-                        md.originSquare = higher + 1;
-                        md.targetSquare = lower + 2;
-                    }
+                    // the origin and target squares of the move are those of the king
+                    return Move::create(higher + 1, lower + 2, KING, NO_PIECE, MoveType::LONG_CASTLE, side);
                 }
 
                 break;
             }
         }
 
-        // if the move type is regular, which would indicate that the castle move was unsuccessful 
-        // (likely due to no privileges), then we need to set the move to invalid so it isn't added
-        // to the move vector
-        if (md.moveType == MoveType::REGULAR)
-            md.moveType = MoveType::INVALID;
+        // the side did not have the privileges needed to make the castle
+        return NULL_MOVE;
+    }
 
-        return md;
+    // this function generates all the moves like any other call to calculateSideMoves, but it only adds
+    // moves that involve captures to the move list
+    void calculateCaptureMoves(Board* board, Colour side, MoveList& moveList)
+    {
+        calculateSideMoves(board, side, moveList, true);
     }
 
-    // this function generates all the moves like any other call to calculateSideMoves, but it only adds 
-    // moves that involve captures to the move vector
-    void calculateCaptureMoves(Board* board, Colour side, std::vector<MoveData>& moveVec)
+    // returns a bitboard with every square that the attacking side attacks, given the occupancy passed in
+    template <Colour attackingSide>
+    Bitboard computeAttackedSquares(Board* board, Bitboard occupiedBB)
     {
-        calculateSideMoves(board, side, moveVec, true);
+        ChessPosition& position = board->currentPosition;
+        Bitboard attacksBB = 0;
+
+        for (Bitboard piecesBB = position.getPieceBB(attackingSide, PAWN); piecesBB; piecesBB &= piecesBB - 1)
+            attacksBB |= pawnAttackLookupTable[attackingSide][BB::getLSB(piecesBB)];
+
+        for (Bitboard piecesBB = position.getPieceBB(attackingSide, KNIGHT); piecesBB; piecesBB &= piecesBB - 1)
+            attacksBB |= knightLookupTable[BB::getLSB(piecesBB)];
+
+        // the sliders are filled all at once rather than being looked up one at a time
+        Bitboard orthogonalAttacksBB, diagonalAttacksBB;
+        BB::slidingAttacks(position.getPieceBB(attackingSide, ROOK)   | position.getPieceBB(attackingSide, QUEEN),
+                           position.getPieceBB(attackingSide, BISHOP) | position.getPieceBB(attackingSide, QUEEN),
+                           ~occupiedBB, &orthogonalAttacksBB, &diagonalAttacksBB);
+        attacksBB |= orthogonalAttacksBB | diagonalAttacksBB;
+
+        for (Bitboard piecesBB = position.getPieceBB(attackingSide, KING); piecesBB; piecesBB &= piecesBB - 1)
+            attacksBB |= kingLookupTable[BB::getLSB(piecesBB)];
+
+        return attacksBB;
     }
 
-    // returns the piece bitboard that the piece on the given square belongs to
-    // the side parameter is a default arguement with a value of -1. this value of -1 indicates no side was specified and to therefore search all bitboards
-    Bitboard* getPieceBitboard(Board* board, Byte square, Colour side)
+    // computes the checkers, pinned pieces and the squares that the side to move's pieces are allowed to move to
+    template <Colour side>
+    LegalityMasks computeLegalityMasks(Board* board)
     {
-        Bitboard squareBB = BB::boardSquares[square];
+        ChessPosition& position = board->currentPosition;
+        LegalityMasks masks = { 0, 0, 0, ~Bitboard(0), 0 };
+
+        Bitboard kingBB = position.getPieceBB(side, KING);
+
+        // without a king there is nothing to keep safe, so every pseudo legal move is allowed
+        if (!kingBB)
+            return masks;
+
+        masks.kingSquare = BB::getLSB(kingBB);
+
+        // the king is removed from the occupancy, as otherwise a square behind it (along the line of a checking slider) would seem safe
+        masks.kingDangerBB = computeAttackedSquares<!side>(board, position.occupiedBB ^ kingBB);
 
-        if (side == SIDE_WHITE || side == -1)
+        Bitboard enemyBishopsQueensBB = position.getPieceBB(!side, BISHOP) | position.getPieceBB(!side, QUEEN);
+        Bitboard enemyRooksQueensBB   = position.getPieceBB(!side, ROOK)   | position.getPieceBB(!side, QUEEN);
+
+        masks.checkersBB = (pawnAttackLookupTable[side][masks.kingSquare] & position.getPieceBB(!side, PAWN))   |
+                           (knightLookupTable[masks.kingSquare]           & position.getPieceBB(!side, KNIGHT)) |
+                           (computePseudoBishopMoves(masks.kingSquare, position.occupiedBB, 0) & enemyBishopsQueensBB) |
+                           (computePseudoRookMoves(masks.kingSquare, position.occupiedBB, 0)   & enemyRooksQueensBB);
+
+        // the enemy sliders that would attack the king if only enemy pieces were on the board. if exactly one piece stands between
+        // such a slider and the king, and that piece is friendly, then it is pinned
+        Bitboard enemyPiecesBB = position.getColourBB(!side);
+        Bitboard snipersBB = (computePseudoBishopMoves(masks.kingSquare, enemyPiecesBB, 0) & enemyBishopsQueensBB) |
+                             (computePseudoRookMoves(masks.kingSquare, enemyPiecesBB, 0)   & enemyRooksQueensBB);
+
+        for (; snipersBB; snipersBB &= snipersBB - 1)
         {
-            if (squareBB & board->currentPosition.whitePawnsBB)        return &board->currentPosition.whitePawnsBB;
-            else if (squareBB & board->currentPosition.whiteRooksBB)   return &board->currentPosition.whiteRooksBB;
-            else if (squareBB & board->currentPosition.whiteKnightsBB) return &board->currentPosition.whiteKnightsBB;
-            else if (squareBB & board->currentPosition.whiteBishopsBB) return &board->currentPosition.whiteBishopsBB;
-            else if (squareBB & board->currentPosition.whiteQueensBB)  return &board->currentPosition.whiteQueensBB;
-            else if (squareBB & board->currentPosition.whiteKingBB)    return &board->currentPosition.whiteKingBB;
+            Bitboard blockersBB = squaresBetween[masks.kingSquare][BB::getLSB(snipersBB)] & position.occupiedBB;
+            if (blockersBB && !(blockersBB & (blockersBB - 1)))
+                masks.pinnedBB |= blockersBB & position.getColourBB(side);
         }
-        if (side == SIDE_BLACK || side == -1)
+
+        // a single check can be answered by capturing the checker or blocking between it and the king, while a double check
+        // can only be answered by moving the king
+        if (masks.checkersBB)
         {
-            if (squareBB & board->currentPosition.blackPawnsBB)        return &board->currentPosition.blackPawnsBB;
-            else if (squareBB & board->currentPosition.blackRooksBB)   return &board->currentPosition.blackRooksBB;
-            else if (squareBB & board->currentPosition.blackKnightsBB) return &board->currentPosition.blackKnightsBB;
-            else if (squareBB & board->currentPosition.blackBishopsBB) return &board->currentPosition.blackBishopsBB;
-            else if (squareBB & board->currentPosition.blackQueensBB)  return &board->currentPosition.blackQueensBB;
-            else if (squareBB & board->currentPosition.blackKingBB)    return &board->currentPosition.blackKingBB;
+            if (masks.checkersBB & (masks.checkersBB - 1))
+                masks.checkMaskBB = 0;
+            else
+                masks.checkMaskBB = masks.checkersBB | squaresBetween[masks.kingSquare][BB::getLSB(masks.checkersBB)];
         }
 
-        return nullptr;
+        return masks;
     }
 
-    // uses pointer arguements to return the piece bitboard and the value of the piece, given a square on the board
-    void getPieceData(Board* boardPtr, Bitboard** pieceBB, int* pieceValue, Byte square, Colour side)
+    // en passant captures remove two pieces from the same rank at once (which can expose the king in a way that a pin would not catch),
+    // so their legality is checked by looking at the occupancy after the capture directly
+    template <Colour side>
+    bool isEnPassantLegal(Board* board, Byte originSquare, const LegalityMasks& masks)
     {
-        Bitboard squareBB = BB::boardSquares[square];
+        ChessPosition& position = board->currentPosition;
+
+        // the pawn being captured is one square behind the en passant square (from the point of view of the side capturing it)
+        Byte targetSquare = position.enPassantSquare;
+        Bitboard victimBB = BB::backwardOne<side>(BB::boardSquares[targetSquare]);
+
+        // any checker other than the captured pawn would still be giving check after the capture
+        if (masks.checkersBB & ~victimBB)
+            return false;
+
+        Bitboard occupiedBB = (position.occupiedBB ^ BB::boardSquares[originSquare] ^ victimBB) | BB::boardSquares[targetSquare];
 
-        if (side == SIDE_WHITE)
+        Bitboard enemyBishopsQueensBB = position.getPieceBB(!side, BISHOP) | position.getPieceBB(!side, QUEEN);
+        Bitboard enemyRooksQueensBB   = position.getPieceBB(!side, ROOK)   | position.getPieceBB(!side, QUEEN);
+
+        return !(computePseudoBishopMoves(masks.kingSquare, occupiedBB, 0) & enemyBishopsQueensBB) &&
+               !(computePseudoRookMoves(masks.kingSquare, occupiedBB, 0)   & enemyRooksQueensBB);
+    }
+
+    // generates all of the legal castle moves based on the side that's moving, and fills said castle
+    // moves into the move list passed in by reference
+    template <Colour side>
+    void calculateCastleMoves(Board* board, const LegalityMasks& masks, MoveList& moveList)
+    {
+        // a king cannot castle out of check
+        if (masks.checkersBB)
+            return;
+
+        // if the king or rook bitboards are empty, then no castling moves will be possible for this side
+        if (board->currentPosition.getPieceBB(side, KING) == 0 || board->currentPosition.getPieceBB(side, ROOK) == 0)
+            return;
+
+        constexpr CastlingPrivilege shortCastle = side == SIDE_WHITE ? CastlingPrivilege::WHITE_SHORT_CASTLE : CastlingPrivilege::BLACK_SHORT_CASTLE;
+        constexpr CastlingPrivilege longCastle  = side == SIDE_WHITE ? CastlingPrivilege::WHITE_LONG_CASTLE  : CastlingPrivilege::BLACK_LONG_CASTLE;
+
+        // generate the short and long castle moves (if they aren't possible, these will simply be null moves)
+        Move shortCastleMove = computeCastleMove(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, shortCastle);
+        Move longCastleMove  = computeCastleMove(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, longCastle);
+
+        // these if statements will add the castle moves to the move list if they were possible and the king does not pass through
+        // or land on an attacked square (the square it starts on was already checked above)
+        if (!shortCastleMove.isNull() && !(masks.kingDangerBB & squaresBetween[shortCastleMove.originSquare()][shortCastleMove.targetSquare() + 1]))
+            moveList.push_back(shortCastleMove);
+        if (!longCastleMove.isNull() && !(masks.kingDangerBB & squaresBetween[longCastleMove.originSquare()][longCastleMove.targetSquare() - 1]))
+            moveList.push_back(longCastleMove);
+    }
+
+    // uses the calculated moves bitboard to add the actual moves that have been abstracted into the engine (with all the
+    // data necessary to make and unmake moves) to the move list provided
+    template <Colour side>
+    void addMoves(Board* board, PieceType piece, Byte originSquare, Bitboard movesBB, MoveList& moveList, MoveGenType genType)
+    {
+        Bitboard enemyPiecesBB = board->currentPosition.getColourBB(!side);
+
+        // the squares that the piece would capture something by moving to (for a pawn, this includes the en passant square)
+        Bitboard capturesBB = enemyPiecesBB;
+        if (piece == PAWN && board->currentPosition.enPassantSquare != NO_SQUARE)
+            capturesBB |= BB::boardSquares[board->currentPosition.enPassantSquare];
+
+        // only keep the moves that are of the type of moves that are being generated
+        if (genType == MoveGenType::CAPTURE_MOVES)
+            movesBB &= capturesBB;
+        else if (genType == MoveGenType::QUIET_MOVES)
+            movesBB &= ~capturesBB;
+
+        // the rank that the side's pawns promote on
+        Bitboard promotionRankBB = BB::rankMask[BB::relativeRank<side>(BB::RANK_EIGHTH)];
+
+        // each set bit of the moves bitboard is a square that the piece can move to, which needs to be converted into an actual move that the engine can use
+        while (movesBB)
         {
-            if (squareBB & boardPtr->currentPosition.whitePawnsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.whitePawnsBB;
-                *pieceValue = 100;
-            }
-            else if (squareBB & boardPtr->currentPosition.whiteRooksBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.whiteRooksBB;
-                *pieceValue = 500;
-            }
-            else if (squareBB & boardPtr->currentPosition.whiteKnightsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.whiteKnightsBB;
-                *pieceValue = 320;
-            }
-            else if (squareBB & boardPtr->currentPosition.whiteBishopsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.whiteBishopsBB;
-                *pieceValue = 330;
-            }
-            else if (squareBB & boardPtr->currentPosition.whiteQueensBB)
+            Byte square = BB::popLSB(movesBB);
+
+            MoveType moveType = MoveType::REGULAR;
+            PieceType capturedPiece = NO_PIECE;
+
+            // if there is an enemy piece on the square that the piece is moving to, get the type of the piece that would be captured
+            if (BB::boardSquares[square] & enemyPiecesBB)
+                capturedPiece = board->currentPosition.pieces[square];
+
+            // a pawn moving onto the en passant square captures the pawn that is one square behind it
+            else if (piece == PAWN && square == board->currentPosition.enPassantSquare)
             {
-                *pieceBB = &boardPtr->currentPosition.whiteQueensBB;
-                *pieceValue = 900;
+                capturedPiece = PAWN;
+                moveType = MoveType::EN_PASSANT_CAPTURE;
             }
-            else if (squareBB & boardPtr->currentPosition.whiteKingBB)
+
+            // a pawn reaching the last rank can promote to any of these four pieces, so there is a separate move for each of them
+            if (piece == PAWN && (BB::boardSquares[square] & promotionRankBB))
             {
-                *pieceBB = &boardPtr->currentPosition.whiteKingBB;
-                *pieceValue = 20000;
+                moveList.push_back(Move::create(originSquare, square, piece, capturedPiece, MoveType::QUEEN_PROMO,  side));
+                moveList.push_back(Move::create(originSquare, square, piece, capturedPiece, MoveType::ROOK_PROMO,   side));
+                moveList.push_back(Move::create(originSquare, square, piece, capturedPiece, MoveType::BISHOP_PROMO, side));
+                moveList.push_back(Move::create(originSquare, square, piece, capturedPiece, MoveType::KNIGHT_PROMO, side));
             }
+            else
+                moveList.push_back(Move::create(originSquare, square, piece, capturedPiece, moveType, side));
         }
-        else
+    }
+
+    // returns the moves bitboard that a piece of the given type can make from the given square
+    // the type of the piece is a template parameter, so each type of piece gets its own version of this function with only its own moves
+    template <Colour side, PieceType piece>
+    Bitboard computePieceMoves(Board* board, Byte originSquare)
+    {
+        Bitboard friendlyPiecesBB = board->currentPosition.getColourBB(side);
+
+        if constexpr (piece == PAWN)   return computePseudoPawnMoves<side>(originSquare, board->currentPosition.getColourBB(!side), board->currentPosition.emptyBB, board->currentPosition.enPassantSquare);
+        if constexpr (piece == KNIGHT) return computePseudoKnightMoves(originSquare, friendlyPiecesBB);
+        if constexpr (piece == BISHOP) return computePseudoBishopMoves(originSquare, board->currentPosition.occupiedBB, friendlyPiecesBB);
+        if constexpr (piece == ROOK)   return computePseudoRookMoves(originSquare, board->currentPosition.occupiedBB, friendlyPiecesBB);
+        if constexpr (piece == QUEEN)  return computePseudoQueenMoves(originSquare, board->currentPosition.occupiedBB, friendlyPiecesBB);
+        if constexpr (piece == KING)   return computePseudoKingMoves(originSquare, friendlyPiecesBB);
+    }
+
+    // returns the moves bitboard that the piece on a given square can make, for when the type of the piece is only known at runtime
+    // the switch statement in the function essentially just checks which type of piece the piece is, and then
+    // calls the version of computePieceMoves for the given piece type
+    template <Colour side>
+    Bitboard calculatePsuedoMove(Board* board, PieceType piece, Byte originSquare)
+    {
+        switch (piece)
         {
-            if (squareBB & boardPtr->currentPosition.blackPawnsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackPawnsBB;
-                *pieceValue = 100;
-            }
-            else if (squareBB & boardPtr->currentPosition.blackRooksBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackRooksBB;
-                *pieceValue = 500;
-            }
-            else if (squareBB & boardPtr->currentPosition.blackKnightsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackKnightsBB;
-                *pieceValue = 320;
-            }
-            else if (squareBB & boardPtr->currentPosition.blackBishopsBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackBishopsBB;
-                *pieceValue = 330;
-            }
-            else if (squareBB & boardPtr->currentPosition.blackQueensBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackQueensBB;
-                *pieceValue = 900;
-            }
-            else if (squareBB & boardPtr->currentPosition.blackKingBB)
-            {
-                *pieceBB = &boardPtr->currentPosition.blackKingBB;
-                *pieceValue = 20000;
-            }
+            case PAWN:   return computePieceMoves<side, PAWN>(board, originSquare);
+            case KNIGHT: return computePieceMoves<side, KNIGHT>(board, originSquare);
+            case BISHOP: return computePieceMoves<side, BISHOP>(board, originSquare);
+            case ROOK:   return computePieceMoves<side, ROOK>(board, originSquare);
+            case QUEEN:  return computePieceMoves<side, QUEEN>(board, originSquare);
+            case KING:   return computePieceMoves<side, KING>(board, originSquare);
+            default:     return 0;
         }
     }
 
-    // generates all of the possible (pseudo) moves that the side to make can be made with the current position 
-    // the MoveData vector that is passed in by reference is filled with all these possible moves
-    void calculateSideMoves(Board* board, Colour side, std::vector<MoveData>& moveVec, bool captureOnly)
+    // removes the moves that would leave the king in check from a piece's pseudo moves
+    template <Colour side>
+    inline Bitboard applyLegalityMasks(Board* board, PieceType piece, Byte originSquare, Bitboard movesBB, const LegalityMasks& masks)
     {
-        // clear the move vector and reserve some space for up to 64 moves (just so that there is no performance 
-        // hit when the move vector has to constantly reallocate more and more space)
-        moveVec.clear();
-        moveVec.reserve(64);
+        // the king may go anywhere that is not attacked
+        if (piece == KING)
+            return movesBB & ~masks.kingDangerBB;
 
-        // contains the colour bitboard of the side to move
-        Bitboard colourBB = side == SIDE_WHITE ? board->currentPosition.whitePiecesBB : board->currentPosition.blackPiecesBB;
+        // the en passant capture is checked on its own, as neither the check mask nor the pin line account for the pawn it removes
+        Bitboard enPassantBB = 0;
+        if (piece == PAWN && board->currentPosition.enPassantSquare != NO_SQUARE)
+        {
+            enPassantBB = movesBB & BB::boardSquares[board->currentPosition.enPassantSquare];
+            movesBB ^= enPassantBB;
 
-        // calculautes all of the possible moves for the pieces on each square occupied by the side to move
-        for (int square = 0; square < 64; square++)
-            if (BB::boardSquares[square] & colourBB)
-                calculatePieceMoves(board, side, square, moveVec, captureOnly);
+            if (enPassantBB && !isEnPassantLegal<side>(board, originSquare, masks))
+                enPassantBB = 0;
+        }
 
-        // calculate as well any castle moves (IF we are generating all moves, and not just castle moves)
-        if (!captureOnly)
-            calculateCastleMoves(board, side, moveVec);
+        // every other piece must resolve a check (if there is one), and a pinned piece must stay on the line of the pin
+        movesBB &= masks.checkMaskBB;
+        if (masks.pinnedBB & BB::boardSquares[originSquare])
+            movesBB &= squaresInLine[masks.kingSquare][originSquare];
+
+        return movesBB | enPassantBB;
     }
 
-    // generates all of the possible castle moves based on the side that's moving, and fills said castle
-    // moves into the move vector passed in by reference
-    void calculateCastleMoves(Board* board, Colour side, std::vector<MoveData>& movesVec)
+    // adds the legal moves of every piece of one type to the move list. the pieces are found by popping the set bits off of the
+    // piece bitboard (rather than checking all 64 squares), and the type of the piece never has to be looked up
+    template <Colour side, PieceType piece>
+    void calculatePieceMoves(Board* board, const LegalityMasks& masks, MoveList& moveList, MoveGenType genType)
     {
-        MoveData shortCastleMD, longCastleMD;
+        Bitboard piecesBB = board->currentPosition.getPieceBB(side, piece);
 
-        if (side == SIDE_WHITE)
+        while (piecesBB)
         {
-            // if the king or rook bitboards are empty, then no castling moves will be possible for this side
-            if (board->currentPosition.whiteKingBB == 0 || board->currentPosition.whiteRooksBB == 0)
-                return;
+            Byte originSquare = BB::popLSB(piecesBB);
+
+            // get the moves bitboard for the piece, and remove any moves that would leave the king in check
+            Bitboard movesBB = computePieceMoves<side, piece>(board, originSquare);
+            movesBB = applyLegalityMasks<side>(board, piece, originSquare, movesBB, masks);
 
-            // generate the short and long castle moves (if they aren't possible, these will simply return moves with INVALID move types)
-            shortCastleMD = computeCastleMoveData(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, CastlingPrivilege::WHITE_SHORT_CASTLE);
-            longCastleMD  = computeCastleMoveData(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, CastlingPrivilege::WHITE_LONG_CASTLE);
+            // add the moves to the move list by converting the moves from bitboards to the engine's abstraction of a move
+            // (but only if there are any moves to )
+            if (movesBB)
+                addMoves<side>(board, piece, originSquare, movesBB, moveList, genType);
         }
-        else
+    }
+
+    // adds a pawn move for every square in the targets bitboard, where each pawn moved by the same number of squares (the shift)
+    // to get to its target. this way, the origin of each move can be worked out from its target rather than being looked up
+    template <Colour side, int shift>
+    void addPawnMoves(Board* board, Bitboard targetsBB, MoveList& moveList)
+    {
+        Bitboard promotionRankBB = BB::rankMask[BB::relativeRank<side>(BB::RANK_EIGHTH)];
+
+        // the pawns that reach the last rank have a separate move for each piece that they could promote to
+        for (Bitboard promotionsBB = targetsBB & promotionRankBB; promotionsBB; )
         {
-            // if the king or rook bitboards are empty, then no castling moves will be possible for this side
-            if (board->currentPosition.blackKingBB == 0 || board->currentPosition.blackRooksBB == 0)
-                return;
+            Byte targetSquare = BB::popLSB(promotionsBB);
+            Byte originSquare = targetSquare - shift;
+            PieceType capturedPiece = board->currentPosition.getPieceOnSquare(targetSquare, !side);
+
+            moveList.push_back(Move::create(originSquare, targetSquare, PAWN, capturedPiece, MoveType::QUEEN_PROMO,  side));
+            moveList.push_back(Move::create(originSquare, targetSquare, PAWN, capturedPiece, MoveType::ROOK_PROMO,   side));
+            moveList.push_back(Move::create(originSquare, targetSquare, PAWN, capturedPiece, MoveType::BISHOP_PROMO, side));
+            moveList.push_back(Move::create(originSquare, targetSquare, PAWN, capturedPiece, MoveType::KNIGHT_PROMO, side));
+        }
 
-            // generate the short and long castle moves (if they aren't possible, these will simply return moves with INVALID move types)
-            shortCastleMD = computeCastleMoveData(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, CastlingPrivilege::BLACK_SHORT_CASTLE);
-            longCastleMD  = computeCastleMoveData(side, board->currentPosition.castlePrivileges, board->currentPosition.occupiedBB, CastlingPrivilege::BLACK_LONG_CASTLE);
+        for (targetsBB &= ~promotionRankBB; targetsBB; )
+        {
+            Byte targetSquare = BB::popLSB(targetsBB);
+            moveList.push_back(Move::create(targetSquare - shift, targetSquare, PAWN, board->currentPosition.getPieceOnSquare(targetSquare, !side), MoveType::REGULAR, side));
         }
+    }
 
-        // these if statements will add the castle moves to the move vector if they were psuedo legal
-        if (shortCastleMD.moveType != MoveType::INVALID)
-            movesVec.push_back(shortCastleMD);
-        if (longCastleMD.moveType != MoveType::INVALID)
-            movesVec.push_back(longCastleMD);
-    }
-
-    /*
-        changes the move provided in the arguement's data based on whether or not the move will capture a rook
-        due to how bitwise operators are used to change the castling privileges when a move is made or unmade,
-        some additional factors need to be considered when setting the castlePrivilegesRevoked attribute of the 
-        move's data. for instance, we should only revoke short castling privileges if the rook was in its starting
-        position and the other side had permission to castle on the short side at the time of this move. the same goes
-        for the long castling privileges
-        returns true if the provided move will cause castle privileges to be revoked
-    */
-    bool doesCaptureAffectCastle(Board* board, MoveData* md)
+    // adds the legal moves of every pawn to the move list. rather than computing the moves of each pawn on its own, the whole pawn bitboard
+    // is shifted at once (forwards for pushes, and diagonally for captures), so the targets of every pawn are found with just a few instructions
+    template <Colour side>
+    void calculatePawnMoves(Board* board, const LegalityMasks& masks, MoveList& moveList, MoveGenType genType)
     {
-        bool doesAffectCastlePrivileges = false;
+        ChessPosition& position = board->currentPosition;
+        Bitboard pawnsBB = position.getPieceBB(side, PAWN);
 
-        if (md->capturedPieceBB == &board->currentPosition.blackRooksBB)
+        // pinned pawns can only move along the line of their own pin, so they are handled one at a time (there is rarely more than one)
+        for (Bitboard pinnedPawnsBB = pawnsBB & masks.pinnedBB; pinnedPawnsBB; )
         {
-            doesAffectCastlePrivileges = true;
-            if (md->targetSquare == ChessCoord::H8 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE;
-            else if (md->targetSquare == ChessCoord::A1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_LONG_CASTLE;
-            else
-                doesAffectCastlePrivileges = false;
+            Byte originSquare = BB::popLSB(pinnedPawnsBB);
+
+            Bitboard movesBB = applyLegalityMasks<side>(board, PAWN, originSquare, computePieceMoves<side, PAWN>(board, originSquare), masks);
+            if (movesBB)
+                addMoves<side>(board, PAWN, originSquare, movesBB, moveList, genType);
         }
-        else if (md->capturedPieceBB == &board->currentPosition.whiteRooksBB)
+
+        pawnsBB &= ~masks.pinnedBB;
+
+        // the number of squares that a pawn moves by when pushing or capturing (up the board for white, down the board for black)
+        constexpr int pushShift   = side == SIDE_WHITE ?  8 : -8;
+        constexpr int westShift   = side == SIDE_WHITE ?  7 : -9;
+        constexpr int eastShift   = side == SIDE_WHITE ?  9 : -7;
+
+        if (genType != MoveGenType::CAPTURE_MOVES)
         {
-            doesAffectCastlePrivileges = true;
-            if (md->targetSquare == ChessCoord::H1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE;
-            else if (md->targetSquare == ChessCoord::A1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_LONG_CASTLE;
-            else
-                doesAffectCastlePrivileges = false;
+            // a pawn can push two squares only if it could push one, and it would land on the fourth rank (from the side's point of view)
+            Bitboard singlePushesBB = BB::shift<pushShift>(pawnsBB) & position.emptyBB;
+            Bitboard doublePushesBB = BB::shift<pushShift>(singlePushesBB) & position.emptyBB & BB::rankMask[BB::relativeRank<side>(BB::RANK_FOURTH)];
+
+            addPawnMoves<side, pushShift>(board, singlePushesBB & masks.checkMaskBB, moveList);
+            addPawnMoves<side, pushShift * 2>(board, doublePushesBB & masks.checkMaskBB, moveList);
         }
 
-        return doesAffectCastlePrivileges;
+        if (genType != MoveGenType::QUIET_MOVES)
+        {
+            // the pawns on the edge files are cleared before shifting diagonally, as otherwise their captures would wrap around the board
+            Bitboard targetsBB = position.getColourBB(!side) & masks.checkMaskBB;
+            addPawnMoves<side, westShift>(board, BB::shift<westShift>(pawnsBB & BB::fileClear[BB::FILE_A]) & targetsBB, moveList);
+            addPawnMoves<side, eastShift>(board, BB::shift<eastShift>(pawnsBB & BB::fileClear[BB::FILE_H]) & targetsBB, moveList);
+
+            // there are at most two pawns that can capture en passant, and each capture has its own legality check
+            if (position.enPassantSquare != NO_SQUARE)
+                for (Bitboard capturersBB = pawnAttackLookupTable[!side][position.enPassantSquare] & pawnsBB; capturersBB; )
+                {
+                    Byte originSquare = BB::popLSB(capturersBB);
+                    if (isEnPassantLegal<side>(board, originSquare, masks))
+                        moveList.push_back(Move::create(originSquare, position.enPassantSquare, PAWN, PAWN, MoveType::EN_PASSANT_CAPTURE, side));
+                }
+        }
     }
 
-    // 
-    inline void setEnPassantMoveData(Board* board, int square, Bitboard pieceMovesBB, MoveData* md)
+    template <Colour side>
+    void generateEvasions(Board* board, const LegalityMasks& masks, MoveList& moveList);
+
+    // adds the legal moves of the type asked for to the move list (without clearing it first), using legality masks
+    // that have already been computed for the position
+    template <Colour side>
+    void generateMoves(Board* board, const LegalityMasks& masks, MoveList& moveList, MoveGenType genType)
     {
-        // cheks if an en passant square is currently set on the board (i.e., there is a square that a pawn could move on via the en passant rule)
-        if (board->currentPosition.enPassantSquare < 64)
+        // when in check, only the moves that get the king out of check are generated (and they are found starting from the check itself)
+        if (masks.checkersBB && genType == MoveGenType::ALL_MOVES)
         {
-            // checks to see if the square provided is the same as the en passant square currently set on the board
-            if (BB::boardSquares[square] & BB::boardSquares[board->currentPosition.enPassantSquare])
-            {
-                // passes if the moves bitboard provided contains the en passant square in its possible moves
-                if (pieceMovesBB & BB::boardSquares[board->currentPosition.enPassantSquare])
-                {
-                    /*  
-                        the following two if statements will pass if the piece making the move is a pawn
-                        if it is, it means that the move will be an en passant capture (as it is a pawn moving onto the en passant square)
-                        in this case, we need to set the appropriate data in the move's data, chiefly:
-                            - the pawn that will be captured by the en passant (notice below that it is calculated 
-                              by finding the enemy piece that is 1 square in front of the en passant square)
-                            - the move type must be set to en passant capture so the move can be properly made and unmade
-                    */
-                    if (md->pieceBB == &board->currentPosition.whitePawnsBB)
-                    {
-                        md->capturedPieceBB = getPieceBitboard(board, square - 8, SIDE_BLACK);
-                        md->moveType = MoveType::EN_PASSANT_CAPTURE;
-                    }
-                    else if (md->pieceBB == &board->currentPosition.blackPawnsBB)
-                    {
-                        md->capturedPieceBB = getPieceBitboard(board, square + 8, SIDE_WHITE);
-                        md->moveType = MoveType::EN_PASSANT_CAPTURE;
-                    }
-                }
-            }
+            generateEvasions<side>(board, masks, moveList);
+            return;
+        }
 
-            // the move data always contains the en passant square that is set on the board
-            // this is so that when the move is unmade, the en passant square that was set
-            // on the board can be restored
-            md->enPassantSquare = board->currentPosition.enPassantSquare;
+        // in double check, only the king is able to move (and it cannot castle)
+        if (!masks.checkMaskBB)
+        {
+            calculatePieceMoves<side, KING>(board, masks, moveList, genType);
+            return;
         }
+
+        // calculautes all of the possible moves for each type of piece of the side to move
+        calculatePawnMoves<side>(board, masks, moveList, genType);
+        calculatePieceMoves<side, KNIGHT>(board, masks, moveList, genType);
+        calculatePieceMoves<side, BISHOP>(board, masks, moveList, genType);
+        calculatePieceMoves<side, ROOK>(board, masks, moveList, genType);
+        calculatePieceMoves<side, QUEEN>(board, masks, moveList, genType);
+        calculatePieceMoves<side, KING>(board, masks, moveList, genType);
+
+        // calculate as well any castle moves (IF we are generating quiet moves, and not just capture moves)
+        if (genType != MoveGenType::CAPTURE_MOVES)
+            calculateCastleMoves<side>(board, masks, moveList);
     }
 
-    // uses the calculated moves bitboard to add the actual moves that have been abstracted into the engine (with all the 
-    // data necessary to make and unmake moves) to the MoveData vector provided
-    void addMoves(Board* board, Bitboard movesBB, MoveData& md, std::vector<MoveData>& moveVec, bool captureOnly)
+    // adds the moves that get the king out of check to the move list. rather than generating the moves of every piece and then
+    // throwing away those that do not deal with the check, this starts from the squares that would deal with the check
+    // and finds the pieces that can move to them. the legality masks must be those of a position where the side is in check
+    template <Colour side>
+    void generateEvasions(Board* board, const LegalityMasks& masks, MoveList& moveList)
     {
-        for (int square = 0; square < 64; square++)
-        {
-            // checks to see if the square on the board is one of the squares that the moves bitboard contains
-            // this would mean that we need to convert this into an actual move that the engine can use
-            if (movesBB & BB::boardSquares[square])
-            {
-                // set the default values for the move data
-                md.targetSquare = square;
-                md.capturedPieceBB = nullptr;
-                md.moveType = MoveType::REGULAR;
+        ChessPosition& position = board->currentPosition;
+
+        // the king can always try to step out of check, onto any square that is not attacked
+        Bitboard kingMovesBB = kingLookupTable[masks.kingSquare] & ~position.getColourBB(side) & ~masks.kingDangerBB;
+        addMoves<side>(board, KING, masks.kingSquare, kingMovesBB, moveList, MoveGenType::ALL_MOVES);
 
-                // if there is an enemy piece on the square that the piece is moving to, get the data bout the piece that would be captured
-                if (BB::boardSquares[square] & *md.capturedColourBB)
-                    getPieceData(board, &md.capturedPieceBB, &md.capturedPieceValue, square, !md.side);
+        // in double check, moving the king is the only way out
+        if (!masks.checkMaskBB)
+            return;
 
-                // if there is no captured piece and we are only adding moves that are capture moves, then continue to the next move
-                if (captureOnly && !md.capturedPieceBB)
-                    continue;
+        // a pinned piece can never get the king out of check, as it would have to leave the line of its pin to do so
+        Bitboard moversBB = position.getColourBB(side) & ~masks.pinnedBB & ~position.getPieceBB(side, KING);
+        Bitboard pawnsBB  = position.getPieceBB(side, PAWN) & moversBB;
 
-                // these if statements check to see if a pawn would be promoted by this move
-                if (md.pieceBB == &board->currentPosition.whitePawnsBB && md.targetSquare >= ChessCoord::A8) md.moveType = MoveType::PAWN_PROMOTION;
-                if (md.pieceBB == &board->currentPosition.blackPawnsBB && md.targetSquare <= ChessCoord::H1) md.moveType = MoveType::PAWN_PROMOTION;
+        Bitboard bishopsQueensBB = (position.getPieceBB(side, BISHOP) | position.getPieceBB(side, QUEEN)) & moversBB;
+        Bitboard rooksQueensBB   = (position.getPieceBB(side, ROOK)   | position.getPieceBB(side, QUEEN)) & moversBB;
+        Bitboard knightsBB       = position.getPieceBB(side, KNIGHT) & moversBB;
 
-                setEnPassantMoveData(board, square, movesBB, &md);
+        // the check mask holds the checking piece (which can be captured) and the squares between it and the king (which can be blocked)
+        for (Bitboard targetsBB = masks.checkMaskBB; targetsBB; )
+        {
+            Byte targetSquare = BB::popLSB(targetsBB);
+            Bitboard targetBB = BB::boardSquares[targetSquare];
 
-                // we need to reset the privileges revoked after a move that captures a rook has changed them
-                // otherwise, no matter what move the piece makes (i.e. no capturing the rook), the moves 
-                // castlePrivilegesRevoked attribute will be non-zero (and change the castle privileges)
-                // calling this functions also sets which castlePrivileges will be revoked after making the move
-                bool resetCastlePrivileges = doesCaptureAffectCastle(board, &md);
+            // the pieces (other than pawns) that can move to the target square are those that would attack it from there
+            Bitboard attackersBB = (knightLookupTable[targetSquare] & knightsBB) |
+                                   (computePseudoBishopMoves(targetSquare, position.occupiedBB, 0) & bishopsQueensBB) |
+                                   (computePseudoRookMoves(targetSquare, position.occupiedBB, 0)   & rooksQueensBB);
 
-                moveVec.push_back(md);
+            while (attackersBB)
+            {
+                Byte originSquare = BB::popLSB(attackersBB);
+                addMoves<side>(board, position.pieces[originSquare], originSquare, targetBB, moveList, MoveGenType::ALL_MOVES);
+            }
 
-                if (resetCastlePrivileges)
-                    md.castlePrivilegesRevoked = 0;
+            // pawns capture the checker diagonally, but can only block by pushing forwards (one or two squares)
+            if (targetBB & masks.checkersBB)
+            {
+                for (Bitboard capturersBB = pawnAttackLookupTable[!side][targetSquare] & pawnsBB; capturersBB; )
+                {
+                    Byte originSquare = BB::popLSB(capturersBB);
+                    addMoves<side>(board, PAWN, originSquare, targetBB, moveList, MoveGenType::ALL_MOVES);
+                }
+            }
+            else
+            {
+                Bitboard oneStepOriginBB = BB::backwardOne<side>(targetBB);
+                Bitboard twoStepOriginBB = BB::backwardOne<side>(oneStepOriginBB);
+                Bitboard twoStepRankBB   = BB::rankMask[BB::relativeRank<side>(BB::RANK_FOURTH)];
+
+                if (oneStepOriginBB & pawnsBB)
+                    addMoves<side>(board, PAWN, BB::getLSB(oneStepOriginBB), targetBB, moveList, MoveGenType::ALL_MOVES);
+                else if ((targetBB & twoStepRankBB) && (oneStepOriginBB & position.emptyBB) && (twoStepOriginBB & pawnsBB))
+                    addMoves<side>(board, PAWN, BB::getLSB(twoStepOriginBB), targetBB, moveList, MoveGenType::ALL_MOVES);
             }
         }
+
+        // an en passant capture can get rid of a pawn that just gave check by moving two squares
+        if (position.enPassantSquare != NO_SQUARE)
+            for (Bitboard capturersBB = pawnAttackLookupTable[!side][position.enPassantSquare] & position.getPieceBB(side, PAWN); capturersBB; )
+            {
+                Byte originSquare = BB::popLSB(capturersBB);
+                if (isEnPassantLegal<side>(board, originSquare, masks))
+                    addMoves<side>(board, PAWN, originSquare, BB::boardSquares[position.enPassantSquare], moveList, MoveGenType::ALL_MOVES);
+            }
     }
 
-    // this function will cause certain castle privileges to be revoked based on the move. for instance, the king moving from its starting square (for the first time)
-    // or one of the rooks moving from its starting square (for the first time) will revoke all or some of that side's castle privileges
-    void setCastlePrivileges(Board* board, MoveData* md, bool isKing)
+    // returns true if the move is one that the move generator would generate in the current position. this is used for moves that
+    // come from somewhere other than the move generator (such as the transposition table or the killer moves), as they may
+    // have been found in a different position
+    template <Colour side>
+    bool isMoveLegal(Board* board, const LegalityMasks& masks, Move move)
     {
-        if (isKing)
+        if (move.isNull() || move.side() != side)
+            return false;
+
+        // there are at most two castle moves, so they are simply generated and compared against
+        if (move.isCastle())
         {
-            if (md->side == SIDE_WHITE && md->originSquare == ChessCoord::E1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_LONG_CASTLE;
-            if (md->side == SIDE_WHITE && md->originSquare == ChessCoord::E1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE;
-            if (md->side == SIDE_BLACK && md->originSquare == ChessCoord::E8 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_LONG_CASTLE;
-            if (md->side == SIDE_BLACK && md->originSquare == ChessCoord::E8 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE;
+            MoveList castleMoves;
+            calculateCastleMoves<side>(board, masks, castleMoves);
+
+            for (int i = 0; i < castleMoves.size(); i++)
+                if (castleMoves[i].move == move)
+                    return true;
+
+            return false;
         }
-        else
+
+        // the piece that moves must be on the origin square
+        if (board->currentPosition.getPieceOnSquare(move.originSquare(), side) != move.piece())
+            return false;
+
+        // the piece that is captured must be on the target square (or behind it, for an en passant capture)
+        if (move.moveType() == MoveType::EN_PASSANT_CAPTURE)
         {
-            if (md->side == SIDE_WHITE && md->originSquare == ChessCoord::A1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_LONG_CASTLE;
-            else if (md->side == SIDE_WHITE && md->originSquare == ChessCoord::H1 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::WHITE_SHORT_CASTLE;
-            else if (md->side == SIDE_BLACK && md->originSquare == ChessCoord::A8 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_LONG_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_LONG_CASTLE;
-            else if (md->side == SIDE_BLACK && md->originSquare == ChessCoord::H8 && (board->currentPosition.castlePrivileges & (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE))
-                md->castlePrivilegesRevoked |= (Byte)CastlingPrivilege::BLACK_SHORT_CASTLE;
+            if (move.targetSquare() != board->currentPosition.enPassantSquare)
+                return false;
         }
-    }
+        else if (board->currentPosition.getPieceOnSquare(move.targetSquare(), !side) != move.capturedPiece())
+            return false;
+        else if (move.piece() == PAWN && move.targetSquare() == board->currentPosition.enPassantSquare)
+            return false;
 
-    // returns the moves bitboard that the piece on a given square can make
-    // each if statement in the function essentially just checks which type of piece the piece is, and then
-    // calls the appropriate function that calculates the moves bitboard for the given piece type
-    Bitboard calculatePsuedoMove(Board* board, MoveData* md, Bitboard& pieceBB)
-    {
-        if ((pieceBB & board->currentPosition.whiteKnightsBB) || (pieceBB & board->currentPosition.blackKnightsBB))
-            return computePseudoKnightMoves(md->originSquare, *md->colourBB);
+        // a pawn moving to the last rank must promote, and no other move can
+        bool reachesLastRank = move.piece() == PAWN && (move.targetSquare() >= ChessCoord::A8 || move.targetSquare() <= ChessCoord::H1);
+        if (move.isPromotion() != reachesLastRank)
+            return false;
 
-        else if ((pieceBB & board->currentPosition.whitePawnsBB) || (pieceBB & board->currentPosition.blackPawnsBB))
-            return computePseudoPawnMoves(md->originSquare, md->side, *md->capturedColourBB, board->currentPosition.emptyBB, board->currentPosition.enPassantSquare);
+        // finally, the target square must be one that the piece can legally move to
+        Bitboard movesBB = calculatePsuedoMove<side>(board, move.piece(), move.originSquare());
+        movesBB = applyLegalityMasks<side>(board, move.piece(), move.originSquare(), movesBB, masks);
 
-        else if ((pieceBB & board->currentPosition.whiteBishopsBB) || (pieceBB & board->currentPosition.blackBishopsBB))
-            return computePseudoBishopMoves(md->originSquare, board->currentPosition.occupiedBB, *md->colourBB);
+        return movesBB & BB::boardSquares[move.targetSquare()];
+    }
 
-        else if ((pieceBB & board->currentPosition.whiteQueensBB) || (pieceBB & board->currentPosition.blackQueensBB))
-            return computePseudoQueenMoves(md->originSquare, board->currentPosition.occupiedBB, *md->colourBB);
+    /* 
+        the functions below are the entry points into move generation for when the side to move is only known at runtime.
+        each of them branches on the side once and then calls the version of the function built for that side, so that
+        everything they call has the side (and so the direction of the pawns, the pieces to use, etc) known at compile time
+    */
 
-        // rooks and kings moving may changae the castle privileges of the side moving, so we need to set the proper 
-        // castle privileges based on the move that's being made
-        else if ((pieceBB & board->currentPosition.whiteRooksBB) || (pieceBB & board->currentPosition.blackRooksBB))
-        {
-            setCastlePrivileges(board, md, false);
-            return computePseudoRookMoves(md->originSquare, board->currentPosition.occupiedBB, *md->colourBB);
-        }
-        else if ((pieceBB & board->currentPosition.whiteKingBB) || (pieceBB & board->currentPosition.blackKingBB))
-        {
-            setCastlePrivileges(board, md, true);
-            return computePseudoKingMoves(md->originSquare, *md->colourBB);
-        }
+    LegalityMasks computeLegalityMasks(Board* board, Colour side)
+    {
+        return side == SIDE_WHITE ? computeLegalityMasks<SIDE_WHITE>(board) : computeLegalityMasks<SIDE_BLACK>(board);
+    }
+
+    void generateMoves(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList, MoveGenType genType)
+    {
+        if (side == SIDE_WHITE) generateMoves<SIDE_WHITE>(board, masks, moveList, genType);
+        else                    generateMoves<SIDE_BLACK>(board, masks, moveList, genType);
     }
 
-    // add the moves that a single piece can make to the move vector
-    void calculatePieceMoves(Board* board, Colour side, Byte originSquare, std::vector<MoveData>& moveVec, bool captureOnly)
+    void generateEvasions(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList)
     {
-        // the following code sets the default values for the move's data 
+        if (side == SIDE_WHITE) generateEvasions<SIDE_WHITE>(board, masks, moveList);
+        else                    generateEvasions<SIDE_BLACK>(board, masks, moveList);
+    }
 
-        MoveData md;
-        md.colourBB         = side == SIDE_WHITE ? &board->currentPosition.whitePiecesBB : &board->currentPosition.blackPiecesBB;
-        md.capturedColourBB = side == SIDE_WHITE ? &board->currentPosition.blackPiecesBB : &board->currentPosition.whitePiecesBB;
-        md.side = side;
-        md.originSquare = originSquare;
+    void calculateCastleMoves(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList)
+    {
+        if (side == SIDE_WHITE) calculateCastleMoves<SIDE_WHITE>(board, masks, moveList);
+        else                    calculateCastleMoves<SIDE_BLACK>(board, masks, moveList);
+    }
 
-        Bitboard movesBB = 0;
-        getPieceData(board, &md.pieceBB, &md.pieceValue, originSquare, side);
+    bool isMoveLegal(Board* board, Colour side, const LegalityMasks& masks, Move move)
+    {
+        return side == SIDE_WHITE ? isMoveLegal<SIDE_WHITE>(board, masks, move) : isMoveLegal<SIDE_BLACK>(board, masks, move);
+    }
+
+    // generates all of the legal moves that the side to make can be made with the current position
+    // the move list that is passed in by reference is filled with all these possible moves
+    void calculateSideMoves(Board* board, Colour side, MoveList& moveList, bool captureOnly)
+    {
+        // clear the move list (it has a fixed capacity, so no memory needs to be reserved)
+        moveList.clear();
 
-        // get the moves bitboard for the piece
-        movesBB = calculatePsuedoMove(board, &md, *md.pieceBB);
+        // the checkers, pins and king danger squares are the same for every piece, so they are only computed once
+        LegalityMasks masks = computeLegalityMasks(board, side);
 
-        // add the moves to the move vector by converting the moves from bitboards to the engine's abstraction of a move
-        // (but only if there are any moves to )
-        if (movesBB > 0)
-            addMoves(board, movesBB, md, moveVec, captureOnly);
+        generateMoves(board, side, masks, moveList, captureOnly ? MoveGenType::CAPTURE_MOVES : MoveGenType::ALL_MOVES);
     }
-}
\ No newline at end of file
+}
@@ -1,47 +1,153 @@
 #pragma once
 
-#include <vector>
-
 #include "Bitboard.h"
 #include "MoveData.h"
+#include "MoveList.h"
 
 // this declaration is necessary to prevent circular including
 class Board;
 
+// the sliding attack tables can be indexed with the BMI2 pext instruction rather than a magic multiplication. this is chosen when the
+// engine is built (with the ATHENA_PEXT cmake option, which compiles the whole engine for BMI2), rather than when it starts, so that each
+// lookup is inlined as a single instruction with nothing to check at runtime. an engine built without it runs on any processor
+#ifndef ATHENA_PEXT
+    #define ATHENA_PEXT 0
+#endif
+
+#if ATHENA_PEXT
+    #include <immintrin.h>
+#endif
+
 // defines all of the things used for the generation of moves
 namespace MoveGeneration
 {   
     /* 
         non sliding pieces do not have their moves dictated by the positions of other pieces on the board, 
         and thus previously calculated lookup tables for their moves can be fully computed prior to move
-        generation
+        generation (they are generated at compile time, in MoveGeneration.cpp)
     */
 
     // each element is a Bitboard with all the possible moves for pawns (assuming no pieces are blocking)
     // it's a 2d array as pawns on opposite sides move in opposite directions
-    extern Bitboard pawnAttackLookupTable[2][64]; 
+    extern const std::array<std::array<Bitboard, 64>, 2> pawnAttackLookupTable;
 
     // each element is a Bitboard with all the possible moves for knights
-    extern Bitboard knightLookupTable[64];
+    extern const std::array<Bitboard, 64> knightLookupTable;
 
     // each element is a Bitboard with all the possible moves for the king (assuming no pieces are blocking)
-    extern Bitboard kingLookupTable[64];
+    extern const std::array<Bitboard, 64> kingLookupTable;
+
+    // each element has the squares strictly between the two squares set, if they share a rank, file or diagonal (and is empty otherwise)
+    extern const std::array<std::array<Bitboard, 64>, 64> squaresBetween;
+
+    // each element has the entire line (edge to edge) that passes through both squares set, if they share a rank, file or diagonal
+    extern const std::array<std::array<Bitboard, 64>, 64> squaresInLine;
+
+    // the information needed to only generate legal moves, which is computed once per position before any moves are generated
+    struct LegalityMasks
+    {
+        // the square of the side to move's king
+        Byte kingSquare;
+
+        // the enemy pieces that are giving check to the king
+        Bitboard checkersBB;
+
+        // the friendly pieces that cannot leave the line between the king and an enemy slider without exposing the king
+        Bitboard pinnedBB;
+
+        // the squares that a piece other than the king may move to. when in check, this is the checking piece and the squares between it and
+        // the king (so the check is captured or blocked). when not in check, it is every square, and when in double check, it is no squares
+        Bitboard checkMaskBB;
+
+        // the squares attacked by the enemy, computed as if the king were not on the board (so that it cannot step back along the line of a slider)
+        Bitboard kingDangerBB;
+    };
+
+    /*
+        sliding pieces use "fancy" magic bitboards: for each square, the occupied squares that could block the piece
+        (its rays, minus the edge of the board) are multiplied by a magic number, and the top bits of the product give a
+        unique index into a precomputed table of attacks. more info at https://www.chessprogramming.org/Magic_Bitboards
+    */
+    struct SlidingAttackEntry
+    {
+        // the squares on which a piece could block the slider (the edge squares never change its attacks, so they are excluded)
+        Bitboard mask;
+
+        // the magic number that maps every subset of the mask to its own index in the attack table
+        Bitboard magic;
+
+        // points to the start of this square's section of the shared attack table
+        Bitboard* attacks;
+
+        // 64 minus the number of bits in the mask
+        int shift;
+
+        // pext packs the masked occupancy directly into an index, and the magic multiplication maps it to one (the tables are laid
+        // out according to whichever of the two the engine was built with)
+        unsigned int index(Bitboard occupiedBB) const 
+        { 
+#if ATHENA_PEXT
+            return (unsigned int)_pext_u64(occupiedBB, mask);
+#else
+            return (unsigned int)(((occupiedBB & mask) * magic) >> shift); 
+#endif
+        }
+    };
+
+    extern SlidingAttackEntry rookAttackEntries[64];
+    extern SlidingAttackEntry bishopAttackEntries[64];
 
     void init();
+    const char* getSlidingAttackBackendName();
+    bool verifySlidingAttacks();
 
-    /* pseudo meaning that they do not account for checks */
+    /* pseudo meaning that they do not account for checks (legality is applied afterwards using the LegalityMasks of the position) */
 
     Bitboard computePseudoKingMoves(Byte fromSquare, Bitboard friendlyPiecesBB);
     Bitboard computePseudoKnightMoves(Byte fromSquare, Bitboard friendlyPiecesBB);
-    Bitboard computePseudoPawnMoves(Byte fromSquare, Colour side, Bitboard enemyPiecesBB, Bitboard occupiedSquaresBB, Byte enPassantSquare);
-    Bitboard computePseudoRookMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB);
-    Bitboard computePseudoBishopMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB);
-    Bitboard computePseudoQueenMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB);
+    template <Colour side>
+    Bitboard computePseudoPawnMoves(Byte fromSquare, Bitboard enemyPiecesBB, Bitboard emptyBB, Byte enPassantSquare);
+
+    // the sliding piece functions are a single table lookup, so they are defined here to allow them to be inlined
+    inline Bitboard computePseudoRookMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    {
+        const SlidingAttackEntry& entry = rookAttackEntries[fromSquare];
+        return entry.attacks[entry.index(occupiedBB)] & ~friendlyPiecesBB;
+    }
+
+    inline Bitboard computePseudoBishopMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    {
+        const SlidingAttackEntry& entry = bishopAttackEntries[fromSquare];
+        return entry.attacks[entry.index(occupiedBB)] & ~friendlyPiecesBB;
+    }
+
+    inline Bitboard computePseudoQueenMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB)
+    {
+        return computePseudoRookMoves(fromSquare, occupiedBB, friendlyPiecesBB) | computePseudoBishopMoves(fromSquare, occupiedBB, friendlyPiecesBB);
+    }
+
+    Bitboard computeClassicalRookMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB);
+    Bitboard computeClassicalBishopMoves(Byte fromSquare, Bitboard occupiedBB, Bitboard friendlyPiecesBB);
+
+    // which of a position's legal moves should be generated
+    enum class MoveGenType
+    {
+        ALL_MOVES,
+        CAPTURE_MOVES,
+
+        // every move that does not capture a piece (including castles and promotions that do not capture)
+        QUIET_MOVES,
+    };
+
+    // these take the side to move at runtime, and call the versions of the move generation functions that are built for that side
+    LegalityMasks computeLegalityMasks(Board* board, Colour side);
+    bool isMoveLegal(Board* board, Colour side, const LegalityMasks& masks, Move move);
 
-    void calculatePieceMoves(Board* board, Colour side, Byte originSquare, std::vector<MoveData>& moveVec, bool captureOnly);
-    MoveData computeCastleMoveData(Colour side, Byte privileges, Bitboard occupiedBB, CastlingPrivilege castleType);
+    void generateMoves(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList, MoveGenType genType);
+    void generateEvasions(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList);
+    Move computeCastleMove(Colour side, Byte privileges, Bitboard occupiedBB, CastlingPrivilege castleType);
     
-    void calculateSideMoves(Board* board, Colour side, std::vector<MoveData>& moveVec, bool captureOnly = false);
-    void calculateCaptureMoves(Board* board, Colour side, std::vector<MoveData>& moveVec);
-    void calculateCastleMoves(Board* board, Colour side, std::vector<MoveData>& moveVec);
+    void calculateSideMoves(Board* board, Colour side, MoveList& moveList, bool captureOnly = false);
+    void calculateCaptureMoves(Board* board, Colour side, MoveList& moveList);
+    void calculateCastleMoves(Board* board, Colour side, const LegalityMasks& masks, MoveList& moveList);
 };
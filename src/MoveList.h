@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MoveData.h"
+
+// the most moves that can be legal in any chess position is 218, so 256 leaves room for pseudo legal moves as well
+const int MAX_MOVES = 256;
+
+// a move along with its weighting in regards to prioritization. that is, the score describes how early we should try to search
+// this move. a high value indicates more urgency
+struct ScoredMove
+{
+	Move move;
+	int score;
+};
+
+// a list of moves with a fixed capacity that is stored inline (i.e., on the stack when it is a local variable)
+// this is used instead of an std::vector so that generating moves in the search never has to allocate memory on the heap
+class MoveList
+{
+private:
+	// ScoredMove has no default values, so the storage is left uninitialized when a list is made
+	ScoredMove mMoves[MAX_MOVES];
+
+	// the number of moves currently in the list
+	int mSize = 0;
+
+public:
+	MoveList() {}
+
+	// the list only ever holds copies of moves, so it should never be copied itself (that would copy all 256 slots)
+	MoveList(const MoveList&) = delete;
+	MoveList& operator=(const MoveList&) = delete;
+
+	void push_back(Move move) { mMoves[mSize++] = { move, 0 }; }
+	void clear() 			  { mSize = 0; 					   }
+
+	int size() const   { return mSize; 	   }
+	bool empty() const { return mSize == 0; }
+
+	ScoredMove& operator[](int index) 			  { return mMoves[index]; }
+	const ScoredMove& operator[](int index) const { return mMoves[index]; }
+
+	ScoredMove* begin() { return mMoves; 		 }
+	ScoredMove* end()   { return mMoves + mSize; }
+};
@@ -0,0 +1,261 @@
+#include <utility>
+
+#include "Eval.h"
+#include "MovePicker.h"
+
+// quiet moves that promote a pawn are tried before every other quiet move (as they are hardly quiet)
+const int PROMOTION_SCORE = 1000000000;
+
+// when in check, capturing the checking piece is tried before blocking the check or moving the king
+const int CAPTURE_EVASION_SCORE = 2 * PROMOTION_SCORE;
+
+MovePicker::MovePicker(Board* board, Colour side, Move ttMove, const Move* killerMoves, int numKillerMoves, const int historyHeuristic[64][64])
+{
+    mBoardPtr = board;
+    mSide     = side;
+    mMasks    = board->getLegalityMasks(side);
+    mStage    = STAGE_TT_MOVE;
+
+    mTTMove           = ttMove;
+    mKillerMoves      = killerMoves;
+    mNumKillerMoves   = numKillerMoves;
+    mKillerIndex      = 0;
+    mHistoryHeuristic = historyHeuristic;
+
+    mMoveIndex       = 0;
+    mBadCaptureIndex = 0;
+}
+
+MovePicker::MovePicker(Board* board, Colour side)
+{
+    mBoardPtr = board;
+    mSide     = side;
+    mMasks    = board->getLegalityMasks(side);
+    mStage    = mMasks.checkersBB ? STAGE_GENERATE_EVASIONS : STAGE_GENERATE_QUIESCENCE_CAPTURES;
+
+    mTTMove           = NULL_MOVE;
+    mKillerMoves      = nullptr;
+    mNumKillerMoves   = 0;
+    mKillerIndex      = 0;
+    mHistoryHeuristic = nullptr;
+
+    mMoveIndex       = 0;
+    mBadCaptureIndex = 0;
+}
+
+// scores captures by the value of the piece being captured first, and the (inverse) value of the capturing piece second
+// this is cheap to compute, and the static exchange evaluation is only done once a capture is actually picked
+void MovePicker::scoreCaptures()
+{
+    for (int i = 0; i < mMoves.size(); i++)
+    {
+        Move move = mMoves[i].move;
+        mMoves[i].score = Eval::PIECE_VALUES[move.capturedPiece()] * 8 - move.piece();
+
+        if (move.isPromotion())
+            mMoves[i].score += Eval::PIECE_VALUES[move.promotionPiece()];
+    }
+}
+
+// scores quiet moves by how often they have caused an advantage for the side making them (the history heuristic)
+void MovePicker::scoreQuiets()
+{
+    for (int i = 0; i < mMoves.size(); i++)
+    {
+        Move move = mMoves[i].move;
+        mMoves[i].score = mHistoryHeuristic[move.originSquare()][move.targetSquare()];
+
+        if (move.isPromotion())
+            mMoves[i].score = PROMOTION_SCORE + Eval::PIECE_VALUES[move.promotionPiece()];
+    }
+}
+
+// scores the moves that get out of check: captures by MVV-LVA ahead of everything else, and the other moves by the history heuristic
+// (the quiescence search has no history heuristic, so its non-capturing evasions are only ordered by promotions)
+void MovePicker::scoreEvasions()
+{
+    for (int i = 0; i < mMoves.size(); i++)
+    {
+        Move move = mMoves[i].move;
+
+        if (move.isCapture())
+            mMoves[i].score = CAPTURE_EVASION_SCORE + Eval::PIECE_VALUES[move.capturedPiece()] * 8 - move.piece();
+        else if (move.isPromotion())
+            mMoves[i].score = PROMOTION_SCORE + Eval::PIECE_VALUES[move.promotionPiece()];
+        else
+            mMoves[i].score = mHistoryHeuristic ? mHistoryHeuristic[move.originSquare()][move.targetSquare()] : 0;
+    }
+}
+
+// swaps the highest scored move that has not yet been picked into the next spot of the move list and returns its index
+// only the moves that are actually picked get sorted this way, rather than the entire list
+int MovePicker::pickBestMoveIndex()
+{
+    for (int i = mMoveIndex + 1; i < mMoves.size(); i++)
+        if (mMoves[i].score > mMoves[mMoveIndex].score)
+            std::swap(mMoves[i], mMoves[mMoveIndex]);
+
+    return mMoveIndex++;
+}
+
+// returns true if the move was already handed out by an earlier stage (the transposition table move or a killer move)
+bool MovePicker::wasAlreadyPicked(Move move)
+{
+    if (move == mTTMove)
+        return true;
+
+    // only the killer moves that were reached in STAGE_KILLER_MOVES could have been picked
+    for (int i = 0; i < mKillerIndex; i++)
+        if (move == mKillerMoves[i])
+            return true;
+
+    return false;
+}
+
+Move MovePicker::nextMove()
+{
+    switch (mStage)
+    {
+        case STAGE_TT_MOVE:
+        {
+            mStage = mMasks.checkersBB ? STAGE_GENERATE_EVASIONS : STAGE_GENERATE_CAPTURES;
+
+            // the transposition table move may come from a different position with the same index, so it must be checked
+            if (MoveGeneration::isMoveLegal(mBoardPtr, mSide, mMasks, mTTMove))
+                return mTTMove;
+
+            mTTMove = NULL_MOVE;
+            return nextMove();
+        }
+
+        case STAGE_GENERATE_CAPTURES:
+        {
+            mMoves.clear();
+            MoveGeneration::generateMoves(mBoardPtr, mSide, mMasks, mMoves, MoveGeneration::MoveGenType::CAPTURE_MOVES);
+            scoreCaptures();
+
+            mMoveIndex = 0;
+            mStage = STAGE_GOOD_CAPTURES;
+            return nextMove();
+        }
+
+        case STAGE_GOOD_CAPTURES:
+        {
+            while (mMoveIndex < mMoves.size())
+            {
+                Move move = mMoves[pickBestMoveIndex()].move;
+                if (move == mTTMove)
+                    continue;
+
+                // captures that lose material are set aside until the very end
+                int seeScore = Eval::see(mBoardPtr, move.targetSquare(), mSide, Eval::PIECE_VALUES[move.capturedPiece()]);
+                if (seeScore < 0)
+                {
+                    mBadCaptures.push_back(move);
+                    continue;
+                }
+
+                return move;
+            }
+
+            mStage = STAGE_KILLER_MOVES;
+            return nextMove();
+        }
+
+        case STAGE_KILLER_MOVES:
+        {
+            while (mKillerIndex < mNumKillerMoves)
+            {
+                Move move = mKillerMoves[mKillerIndex++];
+
+                // killer moves come from other positions, so they must be checked (and are only used if they are quiet here as well)
+                if (move != mTTMove && !move.isCapture() && MoveGeneration::isMoveLegal(mBoardPtr, mSide, mMasks, move))
+                    return move;
+            }
+
+            mStage = STAGE_GENERATE_QUIETS;
+            return nextMove();
+        }
+
+        case STAGE_GENERATE_QUIETS:
+        {
+            mMoves.clear();
+            MoveGeneration::generateMoves(mBoardPtr, mSide, mMasks, mMoves, MoveGeneration::MoveGenType::QUIET_MOVES);
+            scoreQuiets();
+
+            mMoveIndex = 0;
+            mStage = STAGE_QUIET_MOVES;
+            return nextMove();
+        }
+
+        case STAGE_QUIET_MOVES:
+        {
+            while (mMoveIndex < mMoves.size())
+            {
+                Move move = mMoves[pickBestMoveIndex()].move;
+                if (!wasAlreadyPicked(move))
+                    return move;
+            }
+
+            mStage = STAGE_BAD_CAPTURES;
+            return nextMove();
+        }
+
+        case STAGE_BAD_CAPTURES:
+        {
+            // the bad captures were set aside in the order of their capture scores, so they are simply returned in that order
+            if (mBadCaptureIndex < mBadCaptures.size())
+                return mBadCaptures[mBadCaptureIndex++].move;
+
+            mStage = STAGE_FINISHED;
+            return NULL_MOVE;
+        }
+
+        case STAGE_GENERATE_QUIESCENCE_CAPTURES:
+        {
+            mMoves.clear();
+            MoveGeneration::generateMoves(mBoardPtr, mSide, mMasks, mMoves, MoveGeneration::MoveGenType::CAPTURE_MOVES);
+            scoreCaptures();
+
+            mMoveIndex = 0;
+            mStage = STAGE_QUIESCENCE_CAPTURES;
+            return nextMove();
+        }
+
+        case STAGE_QUIESCENCE_CAPTURES:
+        {
+            if (mMoveIndex < mMoves.size())
+                return mMoves[pickBestMoveIndex()].move;
+
+            mStage = STAGE_FINISHED;
+            return NULL_MOVE;
+        }
+
+        case STAGE_GENERATE_EVASIONS:
+        {
+            mMoves.clear();
+            MoveGeneration::generateEvasions(mBoardPtr, mSide, mMasks, mMoves);
+            scoreEvasions();
+
+            mMoveIndex = 0;
+            mStage = STAGE_EVASIONS;
+            return nextMove();
+        }
+
+        case STAGE_EVASIONS:
+        {
+            while (mMoveIndex < mMoves.size())
+            {
+                Move move = mMoves[pickBestMoveIndex()].move;
+                if (move != mTTMove)
+                    return move;
+            }
+
+            mStage = STAGE_FINISHED;
+            return NULL_MOVE;
+        }
+
+        default:
+            return NULL_MOVE;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Board.h"
+#include "MoveData.h"
+#include "MoveGeneration.h"
+#include "MoveList.h"
+
+// hands out the legal moves of a position one at a time, in the order that they should be searched
+// the moves are generated and scored in stages, with each stage only being generated once the previous one has been used up.
+// this way, when a move causes a cutoff early on (which is most of the time), the work for the later stages is never done
+class MovePicker
+{
+public:
+    // the stages are gone through in this order
+    enum Stage
+    {
+        // the best move found for this position by a previous search (stored in the transposition table)
+        STAGE_TT_MOVE,
+
+        // captures that do not lose material according to static exchange evaluation, best victim first
+        STAGE_GENERATE_CAPTURES,
+        STAGE_GOOD_CAPTURES,
+
+        // quiet moves that caused a cutoff in a sibling position
+        STAGE_KILLER_MOVES,
+
+        // the rest of the quiet moves, in the order of the history heuristic
+        STAGE_GENERATE_QUIETS,
+        STAGE_QUIET_MOVES,
+
+        // captures that lose material according to static exchange evaluation (these were set aside in STAGE_GOOD_CAPTURES)
+        STAGE_BAD_CAPTURES,
+
+        // the quiescence search only looks at captures, and prunes them itself (so they are not split into good and bad captures)
+        STAGE_GENERATE_QUIESCENCE_CAPTURES,
+        STAGE_QUIESCENCE_CAPTURES,
+
+        // when the side to move is in check, only the moves that get out of check are generated (in both searches).
+        // captures of the checking piece come first, and then the rest of the evasions in the order of the history heuristic
+        STAGE_GENERATE_EVASIONS,
+        STAGE_EVASIONS,
+
+        STAGE_FINISHED,
+    };
+
+private:
+    Board* mBoardPtr;
+    Colour mSide;
+
+    // the checkers and pins of the position, which are needed by every stage that generates moves
+    MoveGeneration::LegalityMasks mMasks;
+
+    Stage mStage;
+
+    Move mTTMove;
+
+    // the killer moves of the ply that the position is at
+    const Move* mKillerMoves;
+    int mNumKillerMoves;
+    int mKillerIndex;
+
+    // the history heuristic table of the search (first index is the origin square, second index is the target square)
+    const int (*mHistoryHeuristic)[64];
+
+    // holds the moves of the stage currently being picked from
+    MoveList mMoves;
+    int mMoveIndex;
+
+    // the losing captures, which are set aside until every quiet move has been picked
+    MoveList mBadCaptures;
+    int mBadCaptureIndex;
+
+    void scoreCaptures();
+    void scoreQuiets();
+    void scoreEvasions();
+
+    int pickBestMoveIndex();
+    bool wasAlreadyPicked(Move move);
+
+public:
+    // picks moves for the main search
+    MovePicker(Board* board, Colour side, Move ttMove, const Move* killerMoves, int numKillerMoves, const int historyHeuristic[64][64]);
+
+    // picks only capture moves (or every evasion when in check), for the quiescence search
+    MovePicker(Board* board, Colour side);
+
+    // returns the next move to search, or a null move once there are no moves left
+    Move nextMove();
+
+    // returns true if the side to move is in check (in which case only evasions are picked)
+    bool isInCheck() const { return mMasks.checkersBB; }
+};
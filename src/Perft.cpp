@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Board.h"
+#include "MoveGeneration.h"
+#include "MoveList.h"
+#include "Perft.h"
+
+namespace Perft
+{
+	// a position with the number of leaf nodes it has at a given depth
+	struct PerftPosition
+	{
+		const char* fenString;
+		int depth;
+		uint64_t nodes;
+	};
+
+	// standard positions with known node counts (from https://www.chessprogramming.org/Perft_Results and the positions collected
+	// by Martin Sedlak). between them, they cover castling through and out of attacks, en passant captures that expose the king,
+	// promotions (including under-promotions) and checks of every kind
+	const PerftPosition referencePositions[] =
+	{
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",                 5, 4865609  },
+		{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",     4, 4085603  },
+		{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",                                6, 11030083 },
+		{ "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",         4, 422333   },
+		{ "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",                4, 2103487  },
+		{ "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594  },
+		{ "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1",                                        6, 1134888  },
+		{ "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1",                                       6, 1015133  },
+		{ "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1",                                      6, 1440467  },
+		{ "5k2/8/8/8/8/8/8/4K2R w K - 0 1",                                           6, 661072   },
+		{ "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1",                                           6, 803711   },
+		{ "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1",                                4, 1274206  },
+		{ "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1",                                 4, 1720476  },
+		{ "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1",                                        6, 3821001  },
+		{ "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1",                                      5, 1004658  },
+		{ "4k3/1P6/8/8/8/8/K7/8 w - - 0 1",                                           6, 217342   },
+		{ "8/P1k5/K7/8/8/8/8/8 w - - 0 1",                                            6, 92683    },
+		{ "K1k5/8/P7/8/8/8/8/8 w - - 0 1",                                            6, 2217     },
+		{ "8/k1P5/8/1K6/8/8/8/8 w - - 0 1",                                           7, 567584   },
+		{ "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1",                                        4, 23527    },
+	};
+
+	// returns the number of leaf nodes that are the given number of moves (depth) away from the board's current position
+	uint64_t perft(Board* boardPtr, int depth)
+	{
+		if (depth == 0)
+			return 1;
+
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, moveList);
+
+		// as the move generator only generates legal moves, each move one ply away from the leaves is a leaf itself
+		// so they are counted all at once (in bulk) rather than each being made and unmade
+		if (depth == 1)
+			return moveList.size();
+
+		uint64_t nodes = 0;
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			boardPtr->makeMove(moveList[i].move);
+			nodes += perft(boardPtr, depth - 1);
+			boardPtr->unmakeMove(moveList[i].move);
+		}
+
+		return nodes;
+	}
+
+	// prints the number of nodes, how long they took to count, and how many nodes were counted per second
+	void printNodesPerSecond(uint64_t nodes, std::chrono::steady_clock::time_point startTime)
+	{
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "nodes " << nodes << " time " << (long long)(seconds * 1000) << " nps " << (long long)(nodes / seconds) << "\n";
+	}
+
+	// runs perft on the board's current position and prints the results
+	void run(Board* boardPtr, int depth)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		uint64_t nodes = perft(boardPtr, depth);
+
+		printNodesPerSecond(nodes, startTime);
+	}
+
+	// runs perft on each of the positions after the moves of the board's current position, printing the number of nodes after each move
+	// when perft gives the wrong number of nodes, comparing these numbers against another engine's narrows down which move is the problem
+	void divide(Board* boardPtr, int depth)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, moveList);
+
+		uint64_t totalNodes = 0;
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			Move move = moveList[i].move;
+
+			boardPtr->makeMove(move);
+			uint64_t nodes = perft(boardPtr, depth - 1);
+			boardPtr->unmakeMove(move);
+
+			std::cout << boardPtr->getMoveLANString(move) << ": " << nodes << "\n";
+			totalNodes += nodes;
+		}
+
+		std::cout << "\nmoves " << moveList.size() << "\n";
+		printNodesPerSecond(totalNodes, startTime);
+	}
+
+	// runs perft on every reference position, and compares the number of nodes with the known number of nodes
+	// returns true if every position had the right number of nodes. note that the board is left in the last reference position
+	bool runSuite(Board* boardPtr)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+
+		uint64_t totalNodes = 0;
+		int numFailed = 0;
+
+		for (const PerftPosition& position : referencePositions)
+		{
+			boardPtr->setPositionFEN(position.fenString);
+			uint64_t nodes = perft(boardPtr, position.depth);
+			totalNodes += nodes;
+
+			bool passed = nodes == position.nodes;
+			if (!passed)
+				numFailed++;
+
+			std::cout << (passed ? "ok   " : "FAIL ") << position.fenString << " depth " << position.depth 
+					  << ": " << nodes << " (expected " << position.nodes << ")\n";
+		}
+
+		std::cout << "\n" << (numFailed ? "failed " : "passed ") << sizeof(referencePositions) / sizeof(PerftPosition) - numFailed 
+				  << "/" << sizeof(referencePositions) / sizeof(PerftPosition) << " positions\n";
+		printNodesPerSecond(totalNodes, startTime);
+
+		return numFailed == 0;
+	}
+
+	// walks the tree of legal moves down to the given depth, and returns the number of positions in which the given check of the board fails
+	// (these checks compare something that the board updates as moves are made with the same thing worked out from scratch)
+	uint64_t countMismatches(Board* boardPtr, int depth, bool (Board::*verify)())
+	{
+		uint64_t mismatches = (boardPtr->*verify)() ? 0 : 1;
+		if (depth == 0)
+			return mismatches;
+
+		// the position after a null move is checked as well (null moves are only made when the side to move is not in check, as in the search)
+		if (!boardPtr->isInCheck(boardPtr->currentPosition.sideToMove))
+		{
+			boardPtr->makeNullMove();
+			mismatches += (boardPtr->*verify)() ? 0 : 1;
+			boardPtr->unmakeNullMove();
+		}
+
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, moveList);
+
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			boardPtr->makeMove(moveList[i].move);
+			mismatches += countMismatches(boardPtr, depth - 1, verify);
+			boardPtr->unmakeMove(moveList[i].move);
+		}
+
+		return mismatches;
+	}
+
+	// runs the given check of the board in every position of the tree of each reference position, and reports the positions that failed it
+	bool verifyInReferencePositions(Board* boardPtr, int depth, bool (Board::*verify)(), const std::string& checkedName)
+	{
+		uint64_t totalMismatches = 0;
+
+		for (const PerftPosition& position : referencePositions)
+		{
+			boardPtr->setPositionFEN(position.fenString);
+			uint64_t mismatches = countMismatches(boardPtr, depth, verify);
+			totalMismatches += mismatches;
+
+			if (mismatches)
+				std::cout << "FAIL " << position.fenString << ": " << mismatches << " positions with the wrong " << checkedName << "\n";
+		}
+
+		std::cout << checkedName << " checked to depth " << depth << ", " << totalMismatches << " mismatches\n";
+		return totalMismatches == 0;
+	}
+
+	// checks the incrementally updated zobrist keys against generated ones in every position of the tree of each reference position
+	bool verifyZobristKeys(Board* boardPtr, int depth)
+	{
+		return verifyInReferencePositions(boardPtr, depth, &Board::verifyZobristKey, "zobrist keys");
+	}
+
+	// checks the incrementally updated midgame/endgame scores and material key against ones summed up from scratch in every position
+	// of the tree of each reference position
+	bool verifyScores(Board* boardPtr, int depth)
+	{
+		return verifyInReferencePositions(boardPtr, depth, &Board::verifyScores, "scores and material keys");
+	}
+
+	// makes and unmakes every move in the tree of legal moves down to the given depth (including the moves to the leaves, which perft skips),
+	// and returns the number of moves that were made
+	uint64_t makeAllMoves(Board* boardPtr, int depth)
+	{
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, moveList);
+
+		uint64_t movesMade = moveList.size();
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			boardPtr->makeMove(moveList[i].move);
+			if (depth > 1)
+				movesMade += makeAllMoves(boardPtr, depth - 1);
+			boardPtr->unmakeMove(moveList[i].move);
+		}
+
+		return movesMade;
+	}
+
+	// measures how quickly moves are made and unmade in the trees of the reference positions, so that the two ways of unmaking a move
+	// (chosen when the engine is built) can be compared. the time also includes generating the moves, which is the same for both
+	void benchMakeMove(Board* boardPtr, int depth)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		uint64_t movesMade = 0;
+
+		for (const PerftPosition& position : referencePositions)
+		{
+			boardPtr->setPositionFEN(position.fenString);
+			movesMade += makeAllMoves(boardPtr, std::min(depth, position.depth));
+		}
+
+		std::cout << (ATHENA_COPY_MAKE ? "copy-make (position copied before each move and copied back to unmake it)"
+									   : "make/unmake (board state saved before each move and the move undone to unmake it)") << ": ";
+		printNodesPerSecond(movesMade, startTime);
+	}
+
+	/*
+		the parallel perft splits the moves of the root position between a number of threads, each of which has its own copy of the board.
+		the threads share a hash table of the node counts of the positions they have already counted (many positions are reached by
+		more than one order of moves), which is lock-free: each entry stores its key XORed with its data, so an entry that was torn by
+		two threads writing it at once will not match any key, and is simply treated as missing
+	*/
+
+	struct PerftHashEntry
+	{
+		// the zobrist key of the position XORed with the data
+		std::atomic<uint64_t> check;
+
+		// the number of nodes in the low 56 bits and the depth that they were counted to in the high 8 bits
+		std::atomic<uint64_t> data;
+	};
+
+	// the hash table shared by the threads of a parallel perft. the number of entries is a power of two so that the index is a mask of the key
+	struct PerftHashTable
+	{
+		std::unique_ptr<PerftHashEntry[]> entries;
+		uint64_t mask;
+
+		PerftHashTable(int sizeMB)
+		{
+			// use the largest power of two number of entries that fits in the size given
+			uint64_t numEntries = 1;
+			while (numEntries * 2 * sizeof(PerftHashEntry) <= (uint64_t)sizeMB * 1024 * 1024)
+				numEntries *= 2;
+
+			entries = std::make_unique<PerftHashEntry[]>(numEntries);
+			mask = numEntries - 1;
+		}
+
+		// the depth is mixed into the index so that the same position at different depths is not always competing for the same entry
+		PerftHashEntry& getEntry(ZobristKey::zkey key, int depth) { return entries[(key ^ (depth * 0x9e3779b97f4a7c15ULL)) & mask]; }
+
+		// returns true (and sets the nodes) if the node count of the position to the depth given is in the table
+		bool probe(ZobristKey::zkey key, int depth, uint64_t* nodes)
+		{
+			PerftHashEntry& entry = getEntry(key, depth);
+
+			uint64_t data = entry.data.load(std::memory_order_relaxed);
+			if ((entry.check.load(std::memory_order_relaxed) ^ data) != key || (int)(data >> 56) != depth)
+				return false;
+
+			*nodes = data & 0x00ffffffffffffffULL;
+			return true;
+		}
+
+		void store(ZobristKey::zkey key, int depth, uint64_t nodes)
+		{
+			PerftHashEntry& entry = getEntry(key, depth);
+
+			uint64_t data = ((uint64_t)depth << 56) | nodes;
+			entry.check.store(key ^ data, std::memory_order_relaxed);
+			entry.data.store(data, std::memory_order_relaxed);
+		}
+	};
+
+	// the same as perft, but looks up (and stores) the node counts of positions in the shared hash table
+	uint64_t hashedPerft(Board* boardPtr, int depth, PerftHashTable& hashTable)
+	{
+		// positions near the leaves are counted faster than they can be looked up, so they are not stored
+		if (depth <= 1)
+			return perft(boardPtr, depth);
+
+		ZobristKey::zkey key = boardPtr->getZobristKey();
+
+		uint64_t nodes;
+		if (hashTable.probe(key, depth, &nodes))
+			return nodes;
+
+		MoveList moveList;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, moveList);
+
+		nodes = 0;
+		for (int i = 0; i < moveList.size(); i++)
+		{
+			boardPtr->makeMove(moveList[i].move);
+			nodes += hashedPerft(boardPtr, depth - 1, hashTable);
+			boardPtr->unmakeMove(moveList[i].move);
+		}
+
+		hashTable.store(key, depth, nodes);
+		return nodes;
+	}
+
+	// counts the leaf nodes of the board's current position with the given number of threads. the threads take the root moves one at a time
+	// (rather than each being given a fixed share of them), so a thread that was given a small subtree will go on to take another one
+	uint64_t parallelPerft(Board* boardPtr, int depth, int numThreads, int hashSizeMB)
+	{
+		if (depth <= 1)
+			return perft(boardPtr, depth);
+
+		MoveList rootMoves;
+		MoveGeneration::calculateSideMoves(boardPtr, boardPtr->currentPosition.sideToMove, rootMoves);
+
+		PerftHashTable hashTable(hashSizeMB);
+
+		std::atomic<int> nextRootMove(0);
+		std::atomic<uint64_t> totalNodes(0);
+
+		std::vector<std::thread> threads;
+		for (int i = 0; i < numThreads; i++)
+			threads.emplace_back([&]()
+			{
+				// each thread makes and unmakes moves on its own copy of the board
+				std::unique_ptr<Board> threadBoard = std::make_unique<Board>(*boardPtr);
+				uint64_t threadNodes = 0;
+
+				for (int moveIndex = nextRootMove++; moveIndex < rootMoves.size(); moveIndex = nextRootMove++)
+				{
+					threadBoard->makeMove(rootMoves[moveIndex].move);
+					threadNodes += hashedPerft(threadBoard.get(), depth - 1, hashTable);
+					threadBoard->unmakeMove(rootMoves[moveIndex].move);
+				}
+
+				totalNodes += threadNodes;
+			});
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		return totalNodes;
+	}
+
+	// runs the parallel perft on the board's current position with 1, 2, 4... threads (up to the maximum number of threads given), and prints
+	// how long each took along with its speedup over a single thread. each run gets a new hash table, so they all start from the same state
+	void runParallel(Board* boardPtr, int depth, int maxThreads, int hashSizeMB)
+	{
+		double singleThreadSeconds = 0;
+
+		for (int numThreads = 1; ; numThreads *= 2)
+		{
+			// the last run always uses the maximum number of threads, even if it is not a power of two
+			numThreads = std::min(numThreads, maxThreads);
+
+			auto startTime = std::chrono::steady_clock::now();
+			uint64_t nodes = parallelPerft(boardPtr, depth, numThreads, hashSizeMB);
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+			if (numThreads == 1)
+				singleThreadSeconds = seconds;
+
+			std::cout << "threads " << numThreads << " nodes " << nodes << " time " << (long long)(seconds * 1000) 
+					  << " nps " << (long long)(nodes / seconds) << " speedup " << singleThreadSeconds / seconds << "\n";
+
+			if (numThreads >= maxThreads)
+				break;
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cinttypes>
+
+// this declaration is necessary to prevent circular including
+class Board;
+
+// perft (performance test) counts the leaf nodes of the tree of legal moves down to a fixed depth. as the counts for many positions
+// are known, this checks that the move generator and Board::makeMove/unmakeMove are correct, and the time it takes measures how fast they are
+namespace Perft
+{
+	uint64_t perft(Board* boardPtr, int depth);
+
+	void run(Board* boardPtr, int depth);
+	void divide(Board* boardPtr, int depth);
+	bool runSuite(Board* boardPtr);
+	bool verifyZobristKeys(Board* boardPtr, int depth);
+	bool verifyScores(Board* boardPtr, int depth);
+	void benchMakeMove(Board* boardPtr, int depth);
+
+	uint64_t parallelPerft(Board* boardPtr, int depth, int numThreads, int hashSizeMB);
+	void runParallel(Board* boardPtr, int depth, int maxThreads, int hashSizeMB);
+};
@@ -4,7 +4,7 @@
 // the values are taken from https://www.chessprogramming.org/Simplified_Evaluation_Function
 namespace pst
 {
-	int pawnTable[64] =
+	constexpr int pawnTable[64] =
 	{
 		 0,  0,  0,   0,  0,  0,  0,  0,
 		 50, 50, 50,  50, 50, 50, 50, 50,
@@ -16,7 +16,7 @@ namespace pst
 		 0,  0,  0,   0,  0,  0,  0,  0
 	};
 
-	int knightTable[64] =
+	constexpr int knightTable[64] =
 	{
 		-50, -40, -30, -30, -30, -30, -40, -50,
 		-40, -20,  0,   0,   0,   0,  -20, -40,
@@ -28,7 +28,7 @@ namespace pst
 		-50, -40, -30, -30, -30, -30, -40, -50,
 	};
 
-	int bishopTable[64] =
+	constexpr int bishopTable[64] =
 	{
 		-20, -10, -10, -10, -10, -10,  -10, -20,
 		-10,  0,   0,   0,   0,   0,    0,  -10,
@@ -40,7 +40,7 @@ namespace pst
 		-20, -10, -10, -10, -10,  -10, -10, -20,
 	};
 
-	int rookTable[64] =
+	constexpr int rookTable[64] =
 	{
 		  0,  0,  0,  0,  0,  0,  0,  0,
 		  5,  10, 10, 10, 10, 10, 10, 5,
@@ -52,7 +52,7 @@ namespace pst
 		  0,  0,  0,  5,  5,  0,  0,  0
 	};
 
-	int queenTable[64] =
+	constexpr int queenTable[64] =
 	{
 		-20, -10, -10, -5, -5, -10, -10, -20,
 		-10,  0,   0,   0,  0,  0,   0,  -10,
@@ -68,7 +68,7 @@ namespace pst
 	// other when the game is in the endgame. this is mostly due to the fact that the king should
 	// be protected early on in the game, but be brought out in the endgame
 
-	int midgameKingTable[64] =
+	constexpr int midgameKingTable[64] =
 	{
 		-30, -40, -40, -50, -50, -40, -40, -30,
 		-30, -40, -40, -50, -50, -40, -40, -30,
@@ -80,7 +80,7 @@ namespace pst
 		 20,  30,  10,  0,   0,   10,  30,  20
 	};
 
-	int endgameKingTable[64] =
+	constexpr int endgameKingTable[64] =
 	{
 		-50, -40, -30, -20, -20, -30, -40, -50,
 		-30, -20, -10,  0,   0,  -10, -20, -30,
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 #include "Constants.h"
 #include "Eval.h"
@@ -10,10 +13,6 @@
 
 namespace UCI
 {
-	// a global instance of the ChessGame class to be used for abstracting the engine and searching for moves
-	// it is defined as a global variable here to prevent UCI from unnecessarily becoming a class
-	ChessGame chessGame;
-
 	// response to the "uci" command
 	void respondUCI()
 	{
@@ -21,19 +20,32 @@ namespace UCI
 		std::cout << "id name Athena 1.0.0\n";
 		std::cout << "id author Nicolas f\n";
 
+		// report which method of looking up sliding piece attacks the engine was built with
+		std::cout << "info string sliding attacks: " << MoveGeneration::getSlidingAttackBackendName() << "\n";
+
 		// options
-		std::cout << "option name Hash type spin default 128 min 1 max 128\n";
+		std::cout << "option name Hash type spin default " << DEFAULT_TRANSPOSITION_TABLE_SIZE << " min 1 max 128\n";
+		std::cout << "option name PawnHash type spin default " << Eval::DEFAULT_PAWN_HASH_SIZE << " min 1 max 128\n";
+		std::cout << "option name IncrementalAttacks type check default false\n";
 
 		// response indicating that the engine is ready for the next command
 		std::cout << "uciok\n";
 	}
 
 	// response to the "setoption" command
-	void respondSetoption(const std::vector<std::string>& commandVec)
+	void respondSetoption(ChessGame& chessGame, const std::vector<std::string>& commandVec)
 	{
 		// if the GUI is changing the size of Athena's transposition table
 		if (commandVec[2] == "Hash")
 			chessGame.setHashSize(std::stoi(commandVec[4]));
+
+		// if the GUI is changing the size of Athena's pawn hash table
+		else if (commandVec[2] == "PawnHash")
+			chessGame.setPawnHashSize(std::stoi(commandVec[4]));
+
+		// if the GUI is changing whether the board keeps its attacks up to date as moves are made, or computes them when they are needed
+		else if (commandVec[2] == "IncrementalAttacks")
+			chessGame.setIncrementalAttacks(commandVec[4] == "true");
 	}
 
 	// response to the "isready" command
@@ -45,45 +57,45 @@ namespace UCI
 
 	// response to commands involving either a move made by the player, or a position being imposed upon the board ("position FEN (fen string) moves...")
 	// note that no cout response is needed for the GUI to know that the engine has interpreted this command
-	void respondPosition(const std::vector<std::string>& commandVec)
+	void respondPosition(ChessGame& chessGame, const std::vector<std::string>& commandVec)
 	{
-		// stores the index of the commandVec where LAN moves start. if the FEN is startpos (the initial position), this index is 3
-		// this can be seen by observing the uci command: position startpos moves ... (first move would be at index 3)
-		int movesCommandIndex = 3;
+		// stores the index of the commandVec where the "moves" keyword is (if there are any moves). if the FEN is startpos (the initial
+		// position), this index is 2, as can be seen by observing the uci command: position startpos moves ... (first move would be at index 3)
+		int movesCommandIndex = 2;
 
 		// the command vector's index of 1 is the start of the FEN string
 		// if it is "startpos", then we want to set the board's position using the actual FEN string for the starting position of a chess game
 		// this FEN string is defined in Constants.h as FEN_STARTING_STRING
-		if (commandVec[1] == "startpos")
-			chessGame.setPositionFEN(FEN_STARTING_STRING);
+		bool positionSet;
+		if (commandVec.size() < 2 || commandVec[1] == "startpos")
+			positionSet = chessGame.setPositionFEN(FEN_STARTING_STRING);
 		else
 		{
-			// if the FEN string being fed to the engine via UCI is not the starting position of a chess game,
-			// then we'll need to get all 6 parts of the FEN string and then give it to the board
-			// note that commandVec[1] in this case would be "fen", so we start at i = 2
+			// if the FEN string being fed to the engine via UCI is not the starting position of a chess game, then all the parts of the FEN
+			// string (up until the moves, if there are any) are put back together and given to the board. the board skips the extra space
+			// left at the end, and allows the move counters to be left out
+			// note that commandVec[1] in this case would be "fen", so we start at index 2
 			std::string fenString = "";
-			for (int i = 2; i <= 7; i++)
-				fenString += commandVec[i] + " ";
-
-			// popping the last value off of the FEN string we've put into an std::string will get rid of the final space at the end
-			// (the for loop above puts a space at the end of each part, though the final one is unncessary and will mess up how the
-			// Board class parses the FEN string)
-			fenString.pop_back();
+			for (; movesCommandIndex < commandVec.size() && commandVec[movesCommandIndex] != "moves"; movesCommandIndex++)
+				fenString += commandVec[movesCommandIndex] + " ";
 
-			chessGame.setPositionFEN(fenString);
+			positionSet = chessGame.setPositionFEN(fenString);
+		}
 
-			// because the FEN string took up extra elements of the commands vector, the index at which the LAN moves (if any)
-			// starts is now at an index of 9
-			movesCommandIndex = 9;
+		// the moves cannot be made if the position could not be set, so the board is left as it was
+		if (!positionSet)
+		{
+			std::cout << "info string invalid fen\n";
+			return;
 		}
 
 		// iterate over any possible moves from the FEN string provided that have occured, and make them using the engine's abstractions
-		for (int i = movesCommandIndex; i < commandVec.size(); i++)
+		for (int i = movesCommandIndex + 1; i < commandVec.size(); i++)
 			chessGame.makeMoveLAN(commandVec[i]);
 	}
 
 	// response to the "go" command
-	void respondGo(const std::vector<std::string>& commandVec)
+	void respondGo(ChessGame& chessGame, const std::vector<std::string>& commandVec)
 	{
 		// the time athena has to search for a move. set an effectively infinite amount of time in case the uci gui doesn't specify the time (or time truly is unlimited)
 		float athenaTime = 99999; // in miliseconds
@@ -103,7 +115,7 @@ namespace UCI
 	}
 
 	// processes the commands that the GUI sends to the engine
-	void processCommand(const std::string& commandString)
+	void processCommand(ChessGame& chessGame, const std::string& commandString)
 	{
 		// store the words in the command string into a vector, so that the words can be accessed by index
 		std::vector<std::string> commandVec;
@@ -116,9 +128,11 @@ namespace UCI
 		else if (commandVec[0] == "isready")
 			respondIsReady();
 		else if (commandVec[0] == "position")
-			respondPosition(commandVec);
+			respondPosition(chessGame, commandVec);
 		else if (commandVec[0] == "go")
-			respondGo(commandVec);
+			respondGo(chessGame, commandVec);
+		else if (commandVec[0] == "setoption" && commandVec.size() > 4)
+			respondSetoption(chessGame, commandVec);
 		else if (commandVec[0] == "quit")
 			exit(0);
 		else if (commandVec[0] == "ucinewgame")
@@ -128,23 +142,86 @@ namespace UCI
 		// it is not a UCI command
 		else if (commandVec[0] == "eval")
 			std::cout << chessGame.getBoardEval() << std::endl;
+
+		// this is a debugging function used to check the sliding piece attack tables against the classical approach
+		// it is not a UCI command
+		else if (commandVec[0] == "verifyattacks")
+			MoveGeneration::verifySlidingAttacks();
+
+		// this is a debugging function used to measure how many nodes the search gets through per second ("bench <depth>")
+		// it is not a UCI command
+		else if (commandVec[0] == "bench")
+			chessGame.bench(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 6);
+
+		// this is a debugging function used to compare the speed of incremental attacks against computing attacks when they are needed
+		// ("benchattacks <depth>"), by running bench and perft with each of them. it is not a UCI command
+		else if (commandVec[0] == "benchattacks")
+			chessGame.benchAttacks(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 6);
+
+		// this is a debugging function used to check that searches can run on many threads at once ("stresssearch <threads> <depth>"), each with
+		// its own board and search, by checking that they get the same results as when they are run one at a time. it is not a UCI command
+		else if (commandVec[0] == "stresssearch")
+			chessGame.stressTest(commandVec.size() > 1 ? std::stoi(commandVec[1]) : std::max(2, (int)std::thread::hardware_concurrency()),
+								 commandVec.size() > 2 ? std::stoi(commandVec[2]) : 5);
+
+		// this is a debugging function used to measure how many FEN strings can be parsed and written per second ("benchfen <iterations>"), which
+		// also checks that positions written out are parsed back the same, and that invalid FEN strings are rejected. it is not a UCI command
+		else if (commandVec[0] == "benchfen")
+			chessGame.benchFEN(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 100000);
+
+		// these are debugging functions used to check the move generator and measure its speed, by counting the leaf nodes of the
+		// current position's move tree ("perft <depth>"), counting them after each move ("divide <depth>"), or checking the node
+		// counts of a set of positions with known counts ("perftsuite"). they are not UCI commands
+		else if (commandVec[0] == "perft" && commandVec.size() > 1)
+			chessGame.perft(std::stoi(commandVec[1]));
+		else if (commandVec[0] == "divide" && commandVec.size() > 1)
+			chessGame.divide(std::stoi(commandVec[1]));
+		else if (commandVec[0] == "perftsuite")
+			chessGame.perftSuite();
+
+		// this is a debugging function used to check that the zobrist keys updated as moves are made match the keys generated from scratch,
+		// in every position of the trees of the perft positions ("verifyzobrist <depth>"). it is not a UCI command
+		else if (commandVec[0] == "verifyzobrist")
+			chessGame.verifyZobristKeys(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 3);
+
+		// this is a debugging function used to check that the midgame and endgame scores and the material key updated as moves are made match
+		// the ones summed up from scratch, in every position of the trees of the perft positions ("verifyscores <depth>"). it is not a UCI command
+		else if (commandVec[0] == "verifyscores")
+			chessGame.verifyScores(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 3);
+
+		// this is a debugging function used to measure how quickly moves are made and unmade ("benchmake <depth>"), so that builds with and
+		// without copy-make can be compared. it is not a UCI command
+		else if (commandVec[0] == "benchmake")
+			chessGame.benchMakeMove(commandVec.size() > 1 ? std::stoi(commandVec[1]) : 4);
+
+		// this is a debugging function used to run perft on many threads at once with a shared hash table ("perftmt <depth> [max threads] [hash MB]")
+		// it is run with 1, 2, 4... threads up to the maximum, to show how well it scales. it is not a UCI command
+		else if (commandVec[0] == "perftmt" && commandVec.size() > 1)
+			chessGame.parallelPerft(std::stoi(commandVec[1]), 
+									commandVec.size() > 2 ? std::stoi(commandVec[2]) : std::max(1, (int)std::thread::hardware_concurrency()),
+									commandVec.size() > 3 ? std::stoi(commandVec[3]) : 64);
 	}
 
 	// waits on GUI input to the engine using the UCI interface, and provokes a response if and when necessary
 	void run()
 	{
-		// the following calls to various init functions initializes the engine
+		// the following calls to various init functions initializes the engine (the lookup tables that never change are generated at
+		// compile time, so these only set up what depends on the processor, such as the sliding attack tables, and the zobrist keys)
+		// this is done once, before any boards or searches are created, as the tables are shared by all of them
+		BB::initialize();
 		MoveGeneration::init();
-		initBitsSetTable();
-		Eval::init();
 		ZobristKey::init();
-		chessGame.init();
+
+		// the game being played belongs to this function rather than being global, so that nothing stops more than one game (each with
+		// its own board and search) from existing at once. it is too large to comfortably fit on the stack, so it is allocated instead
+		std::unique_ptr<ChessGame> chessGame = std::make_unique<ChessGame>();
+		chessGame->init();
 
 		while (true)
 		{
 			std::string uciInput;
 			while (std::getline(std::cin, uciInput))
-				processCommand(uciInput);
+				processCommand(*chessGame, uciInput);
 		}
 	}
 }
\ No newline at end of file
@@ -9,5 +9,5 @@
 namespace UCI
 {
 	void run();
-	void processCommand(const std::string& commandString);
+	void processCommand(ChessGame& chessGame, const std::string& commandString);
 };
\ No newline at end of file
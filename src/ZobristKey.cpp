@@ -6,36 +6,20 @@
 
 namespace ZobristKey
 {
-	enum ColourAndPieceTypes
-	{
-		WHITE_PAWN,
-		WHITE_ROOK,
-		WHITE_BISHOP,
-		WHITE_QUEEN,
-		WHITE_KNIGHT,
-		WHITE_KING,
-
-		BLACK_PAWN,
-		BLACK_ROOK,
-		BLACK_BISHOP,
-		BLACK_QUEEN,
-		BLACK_KNIGHT,
-		BLACK_KING,
-	};
-
 	// stores one hash key (i.e., a random 64 bit integer) for each coloured type of piece on each square
-	uint64_t pieceHashKeys[12][64];
+	// (indexed by the colour of the piece, then by its PieceType, then by the square)
+	zkey pieceHashKeys[2][6][64];
 
 	// stores a hash key that is used whenever white makes a move
-	uint64_t sideToPlayHashKey;
+	zkey sideToPlayHashKey;
 
 	// stores a hash key for each square. although not every square can have an en passant square set on it, 
 	// giving the array a size of 64 allows for easy and efficient indexing
-	uint64_t enpassantHashKeys[64];
+	zkey enpassantHashKeys[64];
 
 	// stores 16 hash keys, one for each combination of castle privileges that a board can have at once 
 	// (4 bits for castle privileges, 2 possible states per bit, 2^4 = 16)
-	uint64_t castleHashKeys[16];
+	zkey castleHashKeys[16];
 
 	// uses the c++ standard library to generate a 64 bit integer
 	uint64_t getRandom64()
@@ -46,9 +30,10 @@ namespace ZobristKey
 	// initializes all of the hash key tables with random 64 bit integers
 	void init()
 	{
-		for (int pieceType = 0; pieceType < 12; pieceType++)
-			for (int square = 0; square < 64; square++)
-				pieceHashKeys[pieceType][square] = getRandom64();
+		for (int side = 0; side < 2; side++)
+			for (int pieceType = PAWN; pieceType <= KING; pieceType++)
+				for (int square = 0; square < 64; square++)
+					pieceHashKeys[side][pieceType][square] = getRandom64();
 
 		for (int castle = 0; castle < 16; castle++)
 			castleHashKeys[castle] = getRandom64();
@@ -59,49 +44,23 @@ namespace ZobristKey
 		sideToPlayHashKey = getRandom64();
 	}
 
-	// returns the hash key for the piece on the given square
-	// does so by determining the colour and type of piece that is on that square, 
-	// then returning the appropriate hash key from the pieces hash table
-	// this override of the function is used for zobrist key generation
+	// returns the hash key for the piece on the given square (which must be occupied)
+	// the type of the piece is read from the position's piece array, so only its colour needs to be determined
 	uint64_t getPieceHashKey(ChessPosition* chessPosition, Byte square)
 	{
-		uint64_t hashkey = 0;
-
-		if (BB::boardSquares[square] & chessPosition->whitePiecesBB)
-		{
-			if	    (BB::boardSquares[square] & chessPosition->whitePawnsBB)   hashkey |=  pieceHashKeys[WHITE_PAWN][square];
-			else if (BB::boardSquares[square] & chessPosition->whiteRooksBB)   hashkey |=  pieceHashKeys[WHITE_ROOK][square];
-			else if (BB::boardSquares[square] & chessPosition->whiteBishopsBB) hashkey |=  pieceHashKeys[WHITE_BISHOP][square];
-			else if (BB::boardSquares[square] & chessPosition->whiteQueensBB)  hashkey |=  pieceHashKeys[WHITE_QUEEN][square];
-			else if (BB::boardSquares[square] & chessPosition->whiteKnightsBB) hashkey |=  pieceHashKeys[WHITE_KNIGHT][square];
-			else if (BB::boardSquares[square] & chessPosition->whiteKingBB)	   hashkey |=  pieceHashKeys[WHITE_KING][square];
-		}
-
-		if (BB::boardSquares[square] & chessPosition->blackPiecesBB)
-		{
-			if		(BB::boardSquares[square] & chessPosition->blackPawnsBB)   hashkey |=  pieceHashKeys[BLACK_PAWN][square];
-			else if (BB::boardSquares[square] & chessPosition->blackRooksBB)   hashkey |=  pieceHashKeys[BLACK_ROOK][square];
-			else if (BB::boardSquares[square] & chessPosition->blackBishopsBB) hashkey |=  pieceHashKeys[BLACK_BISHOP][square];
-			else if (BB::boardSquares[square] & chessPosition->blackQueensBB)  hashkey |=  pieceHashKeys[BLACK_QUEEN][square];
-			else if (BB::boardSquares[square] & chessPosition->blackKnightsBB) hashkey |=  pieceHashKeys[BLACK_KNIGHT][square];
-			else if (BB::boardSquares[square] & chessPosition->blackKingBB)	   hashkey |=  pieceHashKeys[BLACK_KING][square];
-		}
-
-		return hashkey;
+		Colour side = (BB::boardSquares[square] & chessPosition->whitePiecesBB) ? SIDE_WHITE : SIDE_BLACK;
+		return pieceHashKeys[side][chessPosition->pieces[square]][square];
 	}
 
-	// returns a newly generated zobrist key
+	// returns a newly generated zobrist key. the board only does this when its position is set from a FEN string,
+	// as it updates its key with the changes that each move makes from then on (and this is used to check those updates)
 	zkey generate(ChessPosition* chessPosition)
 	{
 		zkey zobristKey = 0;
 
 		// XOR all of the pieces on the board's hash keys
-		for (int square = 0; square < 64; square++)
-		{
-			if (BB::boardSquares[square] & chessPosition->emptyBB) continue;
-
-			zobristKey ^= getPieceHashKey(chessPosition, square);
-		}
+		for (Bitboard occupiedBB = chessPosition->occupiedBB; occupiedBB; )
+			zobristKey ^= getPieceHashKey(chessPosition, BB::popLSB(occupiedBB));
 
 		// XOR the hash key for the castle privileges of the current position
 		zobristKey ^= castleHashKeys[chessPosition->castlePrivileges];
@@ -116,4 +75,18 @@ namespace ZobristKey
 
 		return zobristKey;
 	}
+
+	// returns a newly generated zobrist key of only the pawns of both sides (made up of the same keys that the pawns have in the full zobrist key)
+	// the pawn structure evaluation only depends on the pawns, so positions with the same pawns can share their pawn hash table entry
+	zkey generatePawnKey(ChessPosition* chessPosition)
+	{
+		zkey pawnKey = 0;
+
+		for (Bitboard pawnsBB = chessPosition->whitePawnsBB; pawnsBB; )
+			pawnKey ^= pieceHashKeys[SIDE_WHITE][PAWN][BB::popLSB(pawnsBB)];
+		for (Bitboard pawnsBB = chessPosition->blackPawnsBB; pawnsBB; )
+			pawnKey ^= pieceHashKeys[SIDE_BLACK][PAWN][BB::popLSB(pawnsBB)];
+
+		return pawnKey;
+	}
 }
\ No newline at end of file
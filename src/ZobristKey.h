@@ -10,7 +10,14 @@ namespace ZobristKey
 	// a zobrist key is simply a 64 bit number. more info about them can be found at
 	// https://www.chessprogramming.org/Zobrist_Hashing
 	typedef uint64_t zkey;
+
+	// the random keys that are XORed together to make up a zobrist key. the board uses them directly to update its key as moves are made
+	extern zkey pieceHashKeys[2][6][64];
+	extern zkey sideToPlayHashKey;
+	extern zkey enpassantHashKeys[64];
+	extern zkey castleHashKeys[16];
 	
 	void init();
 	zkey generate(ChessPosition* chessPosition);
+	zkey generatePawnKey(ChessPosition* chessPosition);
 }
\ No newline at end of file
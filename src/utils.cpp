@@ -1,3 +1,4 @@
+#include <array>
 #include <sstream>
 
 #include "utils.h"
@@ -16,13 +17,17 @@ void splitString(const std::string& string, std::vector<std::string>& vec, char
 	details about their implentation can be found at https://www.geeksforgeeks.org/count-set-bits-in-an-integer/
 */
 
-int bitsSetTable256[256];
-
-void initBitsSetTable()
+// the number of bits set in each byte, generated at compile time
+constexpr std::array<int, 256> bitsSetTable256 = []
 {
+	std::array<int, 256> bitsSet {};
 	for (int i = 0; i < 256; i++)
-		bitsSetTable256[i] = (i & 1) + bitsSetTable256[i / 2];
-}
+		bitsSet[i] = (i & 1) + bitsSet[i / 2];
+
+	return bitsSet;
+}();
+
+static_assert(bitsSetTable256[0] == 0 && bitsSetTable256[0x55] == 4 && bitsSetTable256[0xff] == 8, "bitsSetTable256 is wrong");
 
 int countSetBits64(uint64_t number)
 {
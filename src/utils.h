@@ -5,5 +5,4 @@
 #include <cinttypes>
 
 void splitString(const std::string& string, std::vector<std::string>& vec, char toSplitCharacter);
-int countSetBits64(uint64_t number);
-void initBitsSetTable();
\ No newline at end of file
+int countSetBits64(uint64_t number);
\ No newline at end of file